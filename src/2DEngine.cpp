@@ -4,8 +4,11 @@
 #include "Managers/ResourceManager.h"
 
 #include "Core/Utility/Profiler.h"
+#include "Core/ECS/EntityManager.h"
+#include "Core/Rollback/RollbackTransport.h"
 
 #include <iostream>
+#include <string>
 
 #ifdef _WIN32
 #undef main
@@ -13,7 +16,22 @@
 
 int main(int argc, char* args[])
 {
-  
+  // runtime settings
+  // --rollback <player 1|2> <local port> <remote port> starts a rollback match against another instance on this machine
+  int rollbackPlayer = 0;
+  unsigned short rollbackLocalPort = 0, rollbackRemotePort = 0;
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::string(args[i]) == "--max-entities" && i + 1 < argc)
+      EntityManager::Get().SetMaxEntities(static_cast<EntityID>(std::stoul(args[++i])));
+    else if (std::string(args[i]) == "--rollback" && i + 3 < argc)
+    {
+      rollbackPlayer = std::stoi(args[++i]);
+      rollbackLocalPort = static_cast<unsigned short>(std::stoul(args[++i]));
+      rollbackRemotePort = static_cast<unsigned short>(std::stoul(args[++i]));
+    }
+  }
+
   std::cout << "Initializing resource manager...";
   PROFILE_BEGIN_SESSION("InitializeResourceManager", "../profiling_data/Init.json");
   ResourceManager::Get().Initialize();
@@ -26,6 +44,19 @@ int main(int argc, char* args[])
   PROFILE_END_SESSION();
   std::cout << "Success.\n";
 
+  if (rollbackPlayer == 1 || rollbackPlayer == 2)
+  {
+    std::cout << "Starting rollback session as player " << rollbackPlayer << " on port " << rollbackLocalPort << "...";
+    auto transport = std::make_unique<UdpTransport>(rollbackLocalPort, "127.0.0.1", rollbackRemotePort);
+    if (transport->IsOpen())
+    {
+      GameManager::Get().BeginRollbackSession(rollbackPlayer - 1, std::move(transport));
+      std::cout << "Success.\n";
+    }
+    else
+      std::cout << "Failed to open the socket.\n";
+  }
+
   std::cout << "Beginning game loop...\n";
   PROFILE_BEGIN_SESSION("GameLoop", "../profiling_data/Runtime.json");
   GameManager::Get().BeginGameLoop();
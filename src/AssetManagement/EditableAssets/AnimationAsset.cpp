@@ -254,7 +254,7 @@ Vector2<int> AnimationAsset::GenerateAnchorPoint(AnchorPoint anchorType, const S
 {
   Resource<SDL_Texture>& sheetTexture = ResourceManager::Get().GetAsset<SDL_Texture>(spriteSheet.src);
   // Get the window format
-  Uint32 windowFormat = SDL_GetWindowPixelFormat(GRenderer.GetWindow());
+  Uint32 windowFormat = GRenderer.GetWindowFormat();
   std::shared_ptr<SDL_PixelFormat> format = std::shared_ptr<SDL_PixelFormat>(SDL_AllocFormat(windowFormat), SDL_FreeFormat);
 
   // Get the pixel data
@@ -99,7 +99,8 @@ template <> void Resource<GLTexture>::Load()
   if (_resource)
   {
     _resource->LoadFromFile(_pathToResource);
-    if (_resource->ID())
+    // headless textures are never uploaded so they have no ID
+    if (_resource->ID() || GRenderer.IsHeadless())
     {
       _loaded = true;
     }
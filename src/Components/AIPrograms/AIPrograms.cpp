@@ -38,6 +38,13 @@ DefendAfter::~DefendAfter()
 
 InputState DefendAfter::Update(const Transform* t, const StateComponent* s)
 {
+  // stop defending once the reset timer has run out
+  if (isDefending && !timerEntity->GetComponent<TimerContainer>()->Running(TimerCallbacks::ResetDefense))
+  {
+    isDefending = false;
+    wasHit = false;
+  }
+
   // while waiting check for hit
   if(!wasHit)
   {
@@ -50,16 +57,8 @@ InputState DefendAfter::Update(const Transform* t, const StateComponent* s)
     InputState blockCommand = DefendAI::Update(t, s);
     if(s->hitThisFrame && blockCommand != InputState::NONE)
     {
-      resetTimer->Cancel();
-      resetTimer = std::shared_ptr<ActionTimer>(new SimpleActionTimer(
-        [this]()
-        { 
-          isDefending = false;
-          wasHit = false;
-        },
-        50
-      ));
-      timerEntity->GetComponent<TimerContainer>()->timings.push_back(resetTimer);
+      timerEntity->GetComponent<TimerContainer>()->Cancel(TimerCallbacks::ResetDefense);
+      timerEntity->GetComponent<TimerContainer>()->Start(TimerCallbacks::ResetDefense, 50);
     }
 
     ActionState thisDefendingState = s->actionState;
@@ -83,15 +82,7 @@ InputState DefendAfter::Update(const Transform* t, const StateComponent* s)
     // when it gets out of hit stun
     if(s->actionState != ActionState::HITSTUN)
     {
-      resetTimer = std::shared_ptr<ActionTimer>(new SimpleActionTimer(
-        [this]()
-        { 
-          isDefending = false;
-          wasHit = false;
-        },
-        50
-      ));
-      timerEntity->GetComponent<TimerContainer>()->timings.push_back(resetTimer);
+      timerEntity->GetComponent<TimerContainer>()->Start(TimerCallbacks::ResetDefense, 50);
       isDefending = true;
       return DefendAI::Update(t, s);
     }
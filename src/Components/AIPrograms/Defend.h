@@ -3,8 +3,7 @@
 #include "Core/ECS/IComponent.h"
 #include "Components/StateComponent.h"
 #include "Components/AIPrograms/IAIProgram.h"
-
-class ActionTimer;
+#include "Systems/TimerSystem/ActionTimer.h"
 
 //! Program with no state
 struct DefendAI : IAIProgram
@@ -21,7 +20,7 @@ struct DefendAfter : DefendAI
   virtual InputState Update(const Transform* t, const StateComponent* s) override;
   bool wasHit = false;
   bool isDefending = false;
-  std::shared_ptr<ActionTimer> resetTimer;
+  //! Runs a ResetDefense timer, defending stops once it runs out
   std::shared_ptr<Entity> timerEntity;
   ActionState lastDefendingState = ActionState::NONE;
 
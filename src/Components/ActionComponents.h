@@ -81,10 +81,10 @@ template <> struct ComponentInitParams<AnimatedActionComponent>
 };
 
 //! Empty components for indicating which system should be run for handling input
-struct EnactActionComponent : public IComponent {};
+struct EnactActionComponent : public ITag {};
 
 //! Marks the entity as available to check for another action
-struct InputListenerComponent : public IComponent {};
+struct InputListenerComponent : public ITag {};
 
 // Marks entity hittable
 struct HittableState : public IComponent, ISerializable
@@ -113,44 +113,44 @@ struct HittableState : public IComponent, ISerializable
   }
 };
 
-struct AbleToAttackState : public IComponent {};
+struct AbleToAttackState : public ITag {};
 
-struct AbleToSpecialAttackState : public IComponent {};
+struct AbleToSpecialAttackState : public ITag {};
 
-struct AbleToDash : public IComponent {};
+struct AbleToDash : public ITag {};
 
-struct AbleToJump : public IComponent {};
+struct AbleToJump : public ITag {};
 
-struct AbleToWalkLeft : public IComponent {};
+struct AbleToWalkLeft : public ITag {};
 
-struct AbleToWalkRight : public IComponent {};
+struct AbleToWalkRight : public ITag {};
 
-struct AbleToCrouch : public IComponent {};
+struct AbleToCrouch : public ITag {};
 
-struct AbleToReturnToNeutral : public IComponent {};
+struct AbleToReturnToNeutral : public ITag {};
 
 //! Follow up action component - player hit the ground but other player can still OTG
-struct TransitionToKnockdownGroundOTG : public IComponent {};
+struct TransitionToKnockdownGroundOTG : public ITag {};
 
 //! Follow up action component - player cannot otg
-struct TransitionToKnockdownGround : public IComponent {};
+struct TransitionToKnockdownGround : public ITag {};
 
-struct TransitionToNeutral : public IComponent {};
+struct TransitionToNeutral : public ITag {};
 
-struct TransitionToCrouching : public IComponent {};
+struct TransitionToCrouching : public ITag {};
 
 //! Cancel actions
 
-struct CancelOnHitGround : public IComponent {};
+struct CancelOnHitGround : public ITag {};
 
-struct CancelOnDash : public IComponent {};
+struct CancelOnDash : public ITag {};
 
-struct CancelOnJump : public IComponent {};
+struct CancelOnJump : public ITag {};
 
-struct CancelOnSpecial : public IComponent {};
+struct CancelOnSpecial : public ITag {};
 
 // this component will work in conjunction with the HasTargetCombo component (and other action mapping components of that type)
-struct CancelOnNormal : public IComponent {};
+struct CancelOnNormal : public ITag {};
 
 //! Components that describe the enacting parameters for a given action type
 
@@ -195,12 +195,12 @@ struct MovingActionComponent : public IComponent, ISerializable
   void Serialize(std::ostream& os) const override
   {
     Serializer<bool>::Serialize(os, horizontalMovementOnly);
-    os << velocity;
+    Serializer<Vector2<float>>::Serialize(os, velocity);
   }
   void Deserialize(std::istream& is) override
   {
     Serializer<bool>::Deserialize(is, horizontalMovementOnly);
-    is >> velocity;
+    Serializer<Vector2<float>>::Deserialize(is, velocity);
   }
 
   std::string Log() override
@@ -378,10 +378,10 @@ struct TimedActionComponent : public IComponent, ISerializable
   }
 };
 
-struct WaitForAnimationComplete : public IComponent {};
+struct WaitForAnimationComplete : public ITag {};
 
 //! Fully transitions to jumping state
-struct WaitingForJumpAirborne : public IComponent {};
+struct WaitingForJumpAirborne : public ITag {};
 
 
 //! Component for pushing player away from other player when pressuring on the wall - plz move later
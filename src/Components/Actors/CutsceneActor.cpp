@@ -2,6 +2,51 @@
 #include "Components/RenderComponent.h"
 #include "Systems/ActionSystems/EnactActionSystem.h"
 
+namespace
+{
+  //! The action of type T that an actor is running with the timer's owner as its target
+  template <typename T>
+  T* TimedAction(EntityID owner)
+  {
+    ComponentArray<CutsceneActor>& actors = ComponentArray<CutsceneActor>::Get();
+    for (uint32_t i = 0; i < actors.Size(); i++)
+    {
+      T* action = dynamic_cast<T*>(actors.ComponentAt(i).currentAction);
+      if (action && action->target && action->target->GetID() == owner)
+        return action;
+    }
+    return nullptr;
+  }
+}
+
+void CutsceneAction::RegisterTimerCallbacks()
+{
+  TimerCallbacks::Get().Register(TimerCallbacks::FadeAlpha,
+    [](EntityID owner)
+    {
+      if (AlphaFader* fader = TimedAction<AlphaFader>(owner))
+      {
+        fader->target->GetComponent<RenderProperties>()->SetDisplayColor(255, 255, 255, fader->end);
+        fader->complete = true;
+      }
+    },
+    [](EntityID owner, int curr, int total)
+    {
+      //! lerp display alpha
+      if (AlphaFader* fader = TimedAction<AlphaFader>(owner))
+      {
+        const unsigned char alpha = fader->start + static_cast<unsigned char>(static_cast<float>(fader->end - fader->start) * curr / total);
+        fader->target->GetComponent<RenderProperties>()->SetDisplayColor(255, 255, 255, alpha);
+      }
+    });
+
+  TimerCallbacks::Get().Register(TimerCallbacks::FinishWait, [](EntityID owner)
+  {
+    if (WaitForTime* wait = TimedAction<WaitForTime>(owner))
+      wait->complete = true;
+  });
+}
+
 void CutsceneActor::SetActionList(CutsceneAction** actionArray, int size)
 {
   _actionQueue = actionArray;
@@ -42,18 +87,7 @@ void AlphaFader::Begin(EntityID actor)
   //! set to start alpha at beginning
   properties.SetDisplayColor(255, 255, 255, start);
 
-  timer = std::make_shared<ComplexActionTimer>(
-    [this](float curr, float total)
-    {
-      //! lerp display alpha
-      target->GetComponent<RenderProperties>()->SetDisplayColor(255, 255, 255, start + static_cast<unsigned char>(static_cast<float>(end - start) * curr / total));
-    },
-    [this]() {
-      target->GetComponent<RenderProperties>()->SetDisplayColor(255, 255, 255, end);
-      complete = true;
-    },
-      time * 1.0f / secPerFrame);
-  target->GetComponent<TimerContainer>()->timings.push_back(timer);
+  target->GetComponent<TimerContainer>()->Start(TimerCallbacks::FadeAlpha, static_cast<int>(time * 1.0f / secPerFrame));
 }
 
 void WaitForTime::Begin(EntityID actor)
@@ -61,10 +95,5 @@ void WaitForTime::Begin(EntityID actor)
   // target has to be set after
   assert(target != nullptr);
 
-  timer = std::make_shared<SimpleActionTimer>(
-    [this]() {
-      complete = true;
-    },
-    time * 1.0f / secPerFrame);
-  target->GetComponent<TimerContainer>()->timings.push_back(timer);
+  target->GetComponent<TimerContainer>()->Start(TimerCallbacks::FinishWait, static_cast<int>(time * 1.0f / secPerFrame));
 }
@@ -27,6 +27,9 @@ protected:
 
 struct CutsceneAction
 {
+  //! Registers the timer callbacks of the actions that run timers on their target
+  static void RegisterTimerCallbacks();
+
   virtual void Begin(EntityID actor) = 0;
   virtual void OnComplete() = 0;
   virtual bool CheckEndConditions() = 0; 
@@ -90,7 +93,6 @@ struct AlphaFader : public CutsceneAction
 
   unsigned char start, end;
   float time;
-  std::shared_ptr<ComplexActionTimer> timer = nullptr;
   std::shared_ptr<Entity> target;
 };
 
@@ -110,6 +112,5 @@ struct WaitForTime : public CutsceneAction
   bool complete = false;
 
   float time;
-  std::shared_ptr<SimpleActionTimer> timer = nullptr;
   std::shared_ptr<Entity> target;
 };
@@ -36,4 +36,4 @@ struct GameActor : public IComponent, ISerializable
 
 //______________________________________________________________________________
 //! Empty flag for identifying entity as an actor in the scene
-struct Actor : public IComponent {};
+struct Actor : public ITag {};
@@ -37,4 +37,4 @@ public:
 };
 
 //! Empty components for camera flags
-struct CameraFollowsPlayers : public IComponent {};
+struct CameraFollowsPlayers : public ITag {};
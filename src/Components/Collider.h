@@ -28,12 +28,12 @@ public:
 
   virtual void Serialize(std::ostream& os) const override
   {
-    os << rect;
+    Serializer<Rect<T>>::Serialize(os, rect);
   }
 
   virtual void Deserialize(std::istream& is) override
   {
-    is >> rect;
+    Serializer<Rect<T>>::Deserialize(is, rect);
   }
 
   std::string Log() override
@@ -51,4 +51,6 @@ protected:
 
 typedef RectCollider<double> RectColliderD;
 
+template <typename T> struct TrivialSnapshot<RectCollider<T>> : TrivialSnapshotRange<RectCollider<T>, &RectCollider<T>::rect> {};
+
 class Hitbox;
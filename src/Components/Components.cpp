@@ -110,18 +110,18 @@ void RectCollider<T>::Draw()
 
 void Rigidbody::Serialize(std::ostream& os) const
 {
-  os << lastCollisionSide;
-  os << velocity;
-  os << acceleration;
+  Serializer<CollisionSide>::Serialize(os, lastCollisionSide);
+  Serializer<Vector2<float>>::Serialize(os, velocity);
+  Serializer<Vector2<float>>::Serialize(os, acceleration);
   Serializer<bool>::Serialize(os, elasticCollisions);
   Serializer<bool>::Serialize(os, ignoreDynamicColliders);
 }
 
 void Rigidbody::Deserialize(std::istream& is)
 {
-  is >> lastCollisionSide;
-  is >> velocity;
-  is >> acceleration;
+  Serializer<CollisionSide>::Deserialize(is, lastCollisionSide);
+  Serializer<Vector2<float>>::Deserialize(is, velocity);
+  Serializer<Vector2<float>>::Deserialize(is, acceleration);
   Serializer<bool>::Deserialize(is, elasticCollisions);
   Serializer<bool>::Deserialize(is, ignoreDynamicColliders);
 }
@@ -20,14 +20,14 @@ public:
   virtual void Serialize(std::ostream& os) const override
   {
     RectColliderD::Serialize(os);
-    Serializer<HitData>::Serialize(os, tData);
+    tData.Serialize(os);
     Serializer<bool>::Serialize(os, hitFlag);
   }
 
   virtual void Deserialize(std::istream& is) override
   {
     RectColliderD::Deserialize(is);
-    Serializer<HitData>::Deserialize(is, tData);
+    tData.Deserialize(is);
     Serializer<bool>::Deserialize(is, hitFlag);
   }
 };
@@ -4,6 +4,8 @@
 //! hurtbox is the area that you can take damage from an enemy attack
 struct Hurtbox : public RectColliderD {};
 
+template <> struct TrivialSnapshot<Hurtbox> : TrivialSnapshotRange<Hurtbox, &Hurtbox::rect> {};
+
 template <> struct ComponentInitParams<Hurtbox>
 {
   Vector2<double> size;
@@ -6,7 +6,7 @@
 #include "Core/Interfaces/Serializable.h"
 
 // simple move dict to test this out
-const TrieNode<InputState, SpecialInputState> UnivSpecMoveDict
+const SpecialMoveDictionary UnivSpecMoveDict
 {
   std::make_pair(std::list<InputState>{InputState::DOWN, InputState::DOWN | InputState::RIGHT, InputState::RIGHT}, SpecialInputState::QCF),
   std::make_pair(std::list<InputState>{InputState::DOWN, InputState::DOWN | InputState::LEFT, InputState::LEFT}, SpecialInputState::QCB),
@@ -31,7 +31,7 @@ public:
   //! Swaps value with last value. If a different value is swapped in, sp buffer needs to be reevaluated
   void Swap(InputState input);
   //! evaluate possible special motions
-  //SpecialInputState Evaluate(const TrieNode<InputState, SpecialInputState>& spMoveDict) const;
+  //SpecialInputState Evaluate(const SpecialMoveDictionary& spMoveDict) const;
   SpecialInputState const& GetLastSpecialInput() const { return _spMovesBuffer.GetLastSpecialInput(); }
   //!
   void Clear();
@@ -7,7 +7,7 @@ struct SelectedCharacterComponent : public IComponent
 };
 
 //! marks the entity as the loser of the round
-struct LoserComponent : public IComponent {};
+struct LoserComponent : public ITag {};
 
 //! marks which team the entity is on (team A == player 1 and team B == player 2)
 struct TeamComponent : public IComponent
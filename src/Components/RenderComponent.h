@@ -112,9 +112,9 @@ public:
 
   void Serialize(std::ostream& os) const override
   {
-    os << renderScaling;
-    os << rectTransform;
-    os << offset;
+    Serializer<Vector2<float>>::Serialize(os, renderScaling);
+    Serializer<Vector2<float>>::Serialize(os, rectTransform);
+    Serializer<Vector2<float>>::Serialize(os, offset);
     Serializer<AnchorPoint>::Serialize(os, anchor);
     Serializer<bool>::Serialize(os, horizontalFlip);
     Serializer<SDL_Color>::Serialize(os, _displayColor);
@@ -122,9 +122,9 @@ public:
 
   void Deserialize(std::istream& is) override
   {
-    is >> renderScaling;
-    is >> rectTransform;
-    is >> offset;
+    Serializer<Vector2<float>>::Deserialize(is, renderScaling);
+    Serializer<Vector2<float>>::Deserialize(is, rectTransform);
+    Serializer<Vector2<float>>::Deserialize(is, offset);
     Serializer<AnchorPoint>::Deserialize(is, anchor);
     Serializer<bool>::Deserialize(is, horizontalFlip);
     Serializer<SDL_Color>::Deserialize(is, _displayColor);
@@ -13,8 +13,8 @@ struct Gravity : public IComponent, public ISerializable
 {
   Vector2<float> force;
 
-  void Serialize(std::ostream& os) const override { os << force; }
-  void Deserialize(std::istream& is) override { is >> force; }
+  void Serialize(std::ostream& os) const override { Serializer<Vector2<float>>::Serialize(os, force); }
+  void Deserialize(std::istream& is) override { Serializer<Vector2<float>>::Deserialize(is, force); }
   std::string Log() override
   {
     std::stringstream ss;
@@ -24,18 +24,20 @@ struct Gravity : public IComponent, public ISerializable
   }
 };
 
+template <> struct TrivialSnapshot<Gravity> : TrivialSnapshotRange<Gravity, &Gravity::force> {};
+
 //!
 struct Rigidbody : public IComponent, public ISerializable
 {
 public:
   //!
   Rigidbody() : lastCollisionSide(CollisionSide::NONE), elasticCollisions(false), ignoreDynamicColliders(false), IComponent() {}
-  //! Last side(s) on physics collider that collided with another collider
-  CollisionSide lastCollisionSide;
   //! Current velocity on rigidbody
   Vector2<float> velocity;
   //! Current acceleration on rigidbody
   Vector2<float> acceleration;
+  //! Last side(s) on physics collider that collided with another collider
+  CollisionSide lastCollisionSide;
 
   //! Should collisions on this bounce or be rigid
   bool elasticCollisions;
@@ -62,6 +64,10 @@ public:
 
 };
 
+template <> struct TrivialSnapshot<Rigidbody> : TrivialSnapshotRange<Rigidbody, &Rigidbody::velocity, &Rigidbody::acceleration, &Rigidbody::lastCollisionSide, &Rigidbody::elasticCollisions, &Rigidbody::ignoreDynamicColliders> {};
+template <> struct TrivialSnapshot<DynamicCollider> : TrivialSnapshotRange<DynamicCollider, &DynamicCollider::rect> {};
+template <> struct TrivialSnapshot<StaticCollider> : TrivialSnapshotRange<StaticCollider, &StaticCollider::rect> {};
+
 template <> struct ComponentInitParams<DynamicCollider>
 {
   Vector2<float> size;
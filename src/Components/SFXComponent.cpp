@@ -24,8 +24,7 @@ void SFXComponent::OnRemove(const EntityID& entity)
 
 void SFXComponent::ShowHitSparks(bool directionRight)
 {
-  if (_subroutine)
-    _subroutine->Cancel();
+  _sfxEntity->GetComponent<TimerContainer>()->Cancel(TimerCallbacks::HideOwner);
 
   //Vector2<float> size = (Vector2<float>)hitblockSparksInfo.frameSize * _sfxEntity->GetComponent<Transform>()->scale;
 
@@ -36,16 +35,12 @@ void SFXComponent::ShowHitSparks(bool directionRight)
   EnactAnimationActionSystem::PlayAnimation(_sfxEntity->GetID(), "HitSparks", false, 2.5f, true, directionRight);
 
   // set action timer
-  _subroutine = std::shared_ptr<ActionTimer>(new SimpleActionTimer(
-    [this]() { _sfxEntity->RemoveComponent<RenderProperties>(); },
-  12));
-  _sfxEntity->GetComponent<TimerContainer>()->timings.push_back(_subroutine);
+  _sfxEntity->GetComponent<TimerContainer>()->Start(TimerCallbacks::HideOwner, 12);
 }
 
 void SFXComponent::ShowBlockSparks(bool directionRight)
 {
-  if (_subroutine)
-    _subroutine->Cancel();
+  _sfxEntity->GetComponent<TimerContainer>()->Cancel(TimerCallbacks::HideOwner);
 
   //Vector2<float> size = (Vector2<float>)hitblockSparksInfo.frameSize * _sfxEntity->GetComponent<Transform>()->scale;
   
@@ -56,8 +51,5 @@ void SFXComponent::ShowBlockSparks(bool directionRight)
   // add render properties so that the render system shows it
 
   // set action timer
-  _subroutine = std::shared_ptr<ActionTimer>(new SimpleActionTimer(
-    [this]() { _sfxEntity->RemoveComponent<RenderProperties>(); },
-  12));
-  _sfxEntity->GetComponent<TimerContainer>()->timings.push_back(_subroutine);
+  _sfxEntity->GetComponent<TimerContainer>()->Start(TimerCallbacks::HideOwner, 12);
 }
@@ -3,7 +3,6 @@
 #include "Core/ECS/Entity.h"
 
 #include "Core/Math/Vector2.h"
-#include "Systems/TimerSystem/ActionTimer.h"
 
 class SFXComponent : public IComponent
 {
@@ -18,6 +17,5 @@ public:
 
 private:
   std::shared_ptr<Entity> _sfxEntity;
-  std::shared_ptr<ActionTimer> _subroutine;
 
 };
@@ -34,16 +34,16 @@ void Transform::RemoveAllChildren()
 
 void Transform::Serialize(std::ostream& os) const
 {
-  os << position;
-  os << rotation;
-  os << scale;
+  Serializer<Vector2<float>>::Serialize(os, position);
+  Serializer<Vector2<float>>::Serialize(os, rotation);
+  Serializer<Vector2<float>>::Serialize(os, scale);
 }
 
 void Transform::Deserialize(std::istream& is)
 {
-  is >> position;
-  is >> rotation;
-  is >> scale;
+  Serializer<Vector2<float>>::Deserialize(is, position);
+  Serializer<Vector2<float>>::Deserialize(is, rotation);
+  Serializer<Vector2<float>>::Deserialize(is, scale);
 }
 
 std::string Transform::Log()
@@ -23,6 +23,8 @@ struct Transform : public IComponent, public ISerializable
 
 };
 
+template <> struct TrivialSnapshot<Transform> : TrivialSnapshotRange<Transform, &Transform::position, &Transform::scale, &Transform::rotation, &Transform::rect> {};
+
 template <> struct ComponentInitParams<Transform>
 {
   Vector2<float> position;
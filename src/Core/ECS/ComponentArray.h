@@ -1,6 +1,14 @@
 #pragma once
 #include "Core/ECS/IComponent.h"
-#include <array>
+#include "Core/ECS/ComponentList.h"
+#include "Core/ECS/EntityManager.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
 
 class Entity;
 
@@ -10,7 +18,11 @@ public:
   virtual ~IComponentArray() = default;
 };
 
-template<typename T = IComponent>
+//______________________________________________________________________________
+//! Sparse set of component data. Both the packed component storage and the sparse entity index are split into pages
+//! that are allocated the first time they are needed, so memory scales with how many components are actually in use
+//! and pages never move (references stay valid while other entities gain the component)
+template<typename T = IComponent, typename Enable = void>
 class ComponentArray : public IComponentArray
 {
 public:
@@ -24,83 +36,228 @@ public:
   //! Removes component data and disassociates it from entity
   void Remove(EntityID entity);
   //! Checks if entity ID is associated with data in array
-  bool HasComponent(EntityID entity) { return _entityToIndexMap.find(entity) != _entityToIndexMap.end(); }
+  bool HasComponent(EntityID entity) const
+  {
+    const size_t page = entity / PageSize;
+    return page < _sparsePages.size() && _sparsePages[page] && _sparsePages[page][entity % PageSize] != InvalidIndex;
+  }
   //! Gets component data for entity from array
   T& GetComponent(EntityID entity);
-  //! Runs function on each living component data in the array
-  void ForEach(std::function<void(T&)> fn);
+  //! Runs function on each living component data in the array (in packed order)
+  template <typename Fn>
+  void ForEach(Fn&& fn);
+
+  //! Whether the array stores component data (false for tags)
+  static constexpr bool HasStorage = true;
+  //! Number of components stored
+  uint32_t Size() const { return _size; }
+  //! Entity owning the component at the packed index
+  EntityID EntityAt(uint32_t index) const { return _indexToEntity[index]; }
+  //! Component at the packed index
+  T& ComponentAt(uint32_t index) { return At(index); }
+  //! Component at the packed index without marking it dirty
+  const T& ComponentAt(uint32_t index) const { return Peek(index); }
+
+  //! Whether the component at the packed index may have changed since the last ClearDirty. Every non-const access
+  //! marks it, so a clean component is known to be unchanged
+  bool IsDirty(uint32_t index) const { return _densePages[index / PageSize]->dirty[index % PageSize].load(std::memory_order_relaxed); }
+  //! Marks every component clean
+  void ClearDirty();
 
 private:
-  //! default initialization
+  //! Number of elements per page of dense and sparse storage
+  static constexpr uint32_t PageSize = 64;
+  //! Marks a sparse slot as not associated with any component data
+  static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+  //! Uninitialized storage for a page of components. Only slots below _size hold constructed objects
+  struct DensePage
+  {
+    alignas(T) unsigned char storage[sizeof(T) * PageSize];
+    //! Dirty flag of each slot. Atomic because systems reading the same array run in parallel and mark it too
+    std::atomic<bool> dirty[PageSize];
+  };
+
   ComponentArray() = default;
+  ~ComponentArray();
   ComponentArray(const ComponentArray&) = delete;
   ComponentArray(ComponentArray&&) = delete;
   ComponentArray operator=(const ComponentArray&) = delete;
   ComponentArray operator=(ComponentArray&&) = delete;
 
-  //! packed array of components (this will maintain the density in the array)
-  std::array<T, MAX_ENTITIES> _components;
-  //! Entity id to index in array map
-  std::unordered_map<EntityID, uint32_t> _entityToIndexMap;
-  //! Map from an array index to entity ID
-  std::unordered_map<uint32_t, EntityID> _indexToEntityMap;
+  //! Gets the component constructed at the packed index, marking it dirty
+  T& At(uint32_t index)
+  {
+    _densePages[index / PageSize]->dirty[index % PageSize].store(true, std::memory_order_relaxed);
+    return const_cast<T&>(Peek(index));
+  }
+  //! Gets the component constructed at the packed index
+  const T& Peek(uint32_t index) const { return *std::launder(reinterpret_cast<const T*>(_densePages[index / PageSize]->storage + sizeof(T) * (index % PageSize))); }
+  //! Gets the sparse slot for the entity, allocating its page if needed
+  uint32_t& SparseSlot(EntityID entity);
+
+  //! packed pages of components (this will maintain the density in the array)
+  std::vector<std::unique_ptr<DensePage>> _densePages;
+  //! Sparse pages indexed by entity id holding the index into the packed array
+  std::vector<std::unique_ptr<uint32_t[]>> _sparsePages;
+  //! Packed array of the entity ids owning the component at the same index
+  std::vector<EntityID> _indexToEntity;
   //! Total size of valid entries in array
   uint32_t _size = 0;
 
 };
 
+//______________________________________________________________________________
+//! Tag components have no data so there is no storage. Whether the entity has the tag is the bit in its signature,
+//! which is set by whoever attaches the component, so insert and remove have nothing to do
 template <typename T>
-inline void ComponentArray<T>::Insert(EntityID id, T&& component)
+class ComponentArray<T, std::enable_if_t<IsTagComponent<T>>> : public IComponentArray
+{
+public:
+  static ComponentArray<T>& Get()
+  {
+    static ComponentArray<T> array;
+    return array;
+  }
+  //! Tags have no data to insert
+  void Insert(EntityID id, T&& component) {}
+  //! Tags have no data to remove
+  void Remove(EntityID entity) {}
+  //! Checks the tag bit in the entity signature
+  bool HasComponent(EntityID entity) const { return EntityManager::Get().HasComponentBit(entity, ComponentID<T>); }
+  //! All tags of a type are identical, so every entity shares the same instance
+  T& GetComponent(EntityID entity)
+  {
+    assert(HasComponent(entity) && "Entity does not have component.");
+    return _tag;
+  }
+  //! Tags have no storage to iterate, so they never drive a query
+  static constexpr bool HasStorage = false;
+
+  //! Runs function once per entity with the tag
+  template <typename Fn>
+  void ForEach(Fn&& fn)
+  {
+    const EntityID range = EntityManager::Get().IDRange();
+    for (EntityID entity = 0; entity < range; entity++)
+    {
+      if (HasComponent(entity))
+        fn(_tag);
+    }
+  }
+
+private:
+  ComponentArray() = default;
+  ComponentArray(const ComponentArray&) = delete;
+  ComponentArray(ComponentArray&&) = delete;
+  ComponentArray operator=(const ComponentArray&) = delete;
+  ComponentArray operator=(ComponentArray&&) = delete;
+
+  //! Shared instance handed out by GetComponent
+  T _tag;
+
+};
+
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline void ComponentArray<T, Enable>::Insert(EntityID id, T&& component)
 {
   if (!HasComponent(id))
   {
     uint32_t newIndex = _size;
+    if (newIndex / PageSize >= _densePages.size())
+      _densePages.push_back(std::make_unique<DensePage>());
 
-    _entityToIndexMap[id] = newIndex;
-    _indexToEntityMap[newIndex] = id;
-    _components[newIndex] = std::move(component);
-    _components[newIndex].OnAdd(id);
+    // construct then assign so components with custom assignment behave the same as before
+    T* slot = new (_densePages[newIndex / PageSize]->storage + sizeof(T) * (newIndex % PageSize)) T();
+    *slot = std::move(component);
+    _densePages[newIndex / PageSize]->dirty[newIndex % PageSize].store(true, std::memory_order_relaxed);
+
+    SparseSlot(id) = newIndex;
+    _indexToEntity.push_back(id);
+    slot->OnAdd(id);
     _size++;
   }
 }
 
-template <typename T>
-inline void ComponentArray<T>::Remove(EntityID entity)
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline void ComponentArray<T, Enable>::Remove(EntityID entity)
 {
   if (HasComponent(entity))
   {
     // swap element at end into deleted element's place to maintain density
-    uint32_t removedIndex = _entityToIndexMap[entity];
+    uint32_t removedIndex = SparseSlot(entity);
     // get last element
     uint32_t indexLastElement = _size - 1;
     // force old component to be deleted
-    _components[removedIndex].OnRemove(entity);
-    _components[removedIndex] = std::move(_components[indexLastElement]);
+    At(removedIndex).OnRemove(entity);
+    if (removedIndex != indexLastElement)
+      At(removedIndex) = std::move(At(indexLastElement));
+    At(indexLastElement).~T();
 
-    // update map to point to the moved spot
-    EntityID entityLastElemet = _indexToEntityMap[indexLastElement];
-    _entityToIndexMap[entityLastElemet] = removedIndex;
-    _indexToEntityMap[removedIndex] = entityLastElemet;
+    // update sparse index to point to the moved spot
+    EntityID entityLastElement = _indexToEntity[indexLastElement];
+    SparseSlot(entityLastElement) = removedIndex;
+    _indexToEntity[removedIndex] = entityLastElement;
+    _indexToEntity.pop_back();
 
-    // finally erase entries
-    _entityToIndexMap.erase(entity);
-    _indexToEntityMap.erase(indexLastElement);
+    // finally invalidate the removed entity's slot
+    SparseSlot(entity) = InvalidIndex;
 
     --_size;
   }
 }
 
-template <typename T>
-inline T& ComponentArray<T>::GetComponent(EntityID entity)
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline T& ComponentArray<T, Enable>::GetComponent(EntityID entity)
 {
-  return _components[_entityToIndexMap[entity]];
+  assert(HasComponent(entity) && "Entity does not have component.");
+  return At(_sparsePages[entity / PageSize][entity % PageSize]);
 }
 
-template <typename T>
-inline void ComponentArray<T>::ForEach(std::function<void(T&)> fn)
+//______________________________________________________________________________
+template <typename T, typename Enable>
+template <typename Fn>
+inline void ComponentArray<T, Enable>::ForEach(Fn&& fn)
 {
   for (uint32_t i = 0; i < _size; i++)
   {
-    fn(_components[i]);
+    fn(At(i));
   }
 }
+
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline void ComponentArray<T, Enable>::ClearDirty()
+{
+  for (auto& page : _densePages)
+  {
+    for (std::atomic<bool>& dirty : page->dirty)
+      dirty.store(false, std::memory_order_relaxed);
+  }
+}
+
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline uint32_t& ComponentArray<T, Enable>::SparseSlot(EntityID entity)
+{
+  const size_t page = entity / PageSize;
+  if (page >= _sparsePages.size())
+    _sparsePages.resize(page + 1);
+  if (!_sparsePages[page])
+  {
+    _sparsePages[page] = std::make_unique<uint32_t[]>(PageSize);
+    std::fill_n(_sparsePages[page].get(), PageSize, InvalidIndex);
+  }
+  return _sparsePages[page][entity % PageSize];
+}
+
+//______________________________________________________________________________
+template <typename T, typename Enable>
+inline ComponentArray<T, Enable>::~ComponentArray()
+{
+  for (uint32_t i = 0; i < _size; i++)
+    At(i).~T();
+}
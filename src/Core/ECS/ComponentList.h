@@ -0,0 +1,171 @@
+#pragma once
+#include "Globals.h"
+#include "Core/Utility/TypeTraits.h"
+
+//______________________________________________________________________________
+// Forward declarations of every component type (class key must match the definition)
+template <typename T> class RectCollider;
+template <typename TextureType> class RenderComponent;
+class GLTexture;
+
+class AIComponent;
+class Animator;
+class AttackStateComponent;
+class Camera;
+class CutsceneActor;
+class GameInputComponent;
+class Hitbox;
+class RenderProperties;
+class SFXComponent;
+class StateComponent;
+class TextRenderer;
+class Throwbox;
+class ThrowFollower;
+class UIRectangleRenderComponent;
+class UITransform;
+
+struct AbleToAttackState;
+struct AbleToCrouch;
+struct AbleToDash;
+struct AbleToJump;
+struct AbleToReturnToNeutral;
+struct AbleToSpecialAttackState;
+struct AbleToWalkLeft;
+struct AbleToWalkRight;
+struct Actor;
+struct AnimatedActionComponent;
+struct AttackActionComponent;
+struct AttackLinkMap;
+struct CameraFollowsPlayers;
+struct CancelOnDash;
+struct CancelOnHitGround;
+struct CancelOnJump;
+struct CancelOnNormal;
+struct CancelOnSpecial;
+struct CrouchingAction;
+struct DashingAction;
+struct DestroyOnSceneEnd;
+struct DynamicCollider;
+struct EnactActionComponent;
+struct GameActor;
+struct GrappleActionComponent;
+struct Gravity;
+struct HitStateComponent;
+struct HittableState;
+struct Hurtbox;
+struct InputListenerComponent;
+struct JumpingAction;
+struct LoserComponent;
+struct MatchMetaComponent;
+struct MenuItem;
+struct MenuState;
+struct MovingActionComponent;
+struct ReceivedDamageAction;
+struct ReceivedGrappleAction;
+struct Rigidbody;
+struct SelectedCharacterComponent;
+struct StaticCollider;
+struct TeamComponent;
+struct TimedActionComponent;
+struct TimerContainer;
+struct Transform;
+struct TransitionToCrouching;
+struct TransitionToKnockdownGround;
+struct TransitionToKnockdownGroundOTG;
+struct TransitionToNeutral;
+struct UIContainer;
+struct WaitForAnimationComplete;
+struct WaitingForJumpAirborne;
+struct WallMoveComponent;
+struct WallPushComponent;
+
+//______________________________________________________________________________
+//! Every component type that can be attached to an entity. The position in the list is the component ID (and its bit
+//! in the signature), so IDs are the same in every build. Only append to the end of this list, otherwise snapshots
+//! and checksums from binaries built before the change will no longer match
+using ComponentTypes = type_list<
+  // core
+  Transform,
+  Rigidbody,
+  Gravity,
+  RectCollider<double>,
+  DynamicCollider,
+  StaticCollider,
+  Hurtbox,
+  Hitbox,
+  Throwbox,
+  ThrowFollower,
+  // rendering
+  RenderComponent<GLTexture>,
+  RenderProperties,
+  Animator,
+  TextRenderer,
+  Camera,
+  CameraFollowsPlayers,
+  SFXComponent,
+  // input and actors
+  GameInputComponent,
+  AIComponent,
+  Actor,
+  GameActor,
+  CutsceneActor,
+  StateComponent,
+  TeamComponent,
+  AttackStateComponent,
+  HitStateComponent,
+  AttackLinkMap,
+  TimerContainer,
+  // action state
+  InputListenerComponent,
+  EnactActionComponent,
+  AnimatedActionComponent,
+  AttackActionComponent,
+  MovingActionComponent,
+  TimedActionComponent,
+  GrappleActionComponent,
+  ReceivedDamageAction,
+  ReceivedGrappleAction,
+  DashingAction,
+  JumpingAction,
+  CrouchingAction,
+  HittableState,
+  WallPushComponent,
+  WaitForAnimationComplete,
+  WaitingForJumpAirborne,
+  AbleToAttackState,
+  AbleToSpecialAttackState,
+  AbleToCrouch,
+  AbleToDash,
+  AbleToJump,
+  AbleToReturnToNeutral,
+  AbleToWalkLeft,
+  AbleToWalkRight,
+  CancelOnDash,
+  CancelOnHitGround,
+  CancelOnJump,
+  CancelOnNormal,
+  CancelOnSpecial,
+  TransitionToCrouching,
+  TransitionToKnockdownGround,
+  TransitionToKnockdownGroundOTG,
+  TransitionToNeutral,
+  // scene and ui
+  WallMoveComponent,
+  DestroyOnSceneEnd,
+  MatchMetaComponent,
+  LoserComponent,
+  SelectedCharacterComponent,
+  MenuState,
+  MenuItem,
+  UIContainer,
+  UITransform,
+  UIRectangleRenderComponent
+>;
+
+//! Number of component types
+constexpr size_t NComponents = ComponentTypes::size;
+static_assert(NComponents <= MAX_COMPONENTS, "Too many component types for the signature bitset");
+
+//! ID of the component type (its bit in the entity signature)
+template <typename T>
+constexpr size_t ComponentID = type_list_index<T, ComponentTypes>::value;
@@ -1,12 +1,29 @@
 #pragma once
 #include "Core/ECS/IComponent.h"
+#include "Core/ECS/ComponentList.h"
 #include "Core/ECS/ECSCoordinator.h"
-
-//! Mainly used to map component manipulation function to an ID value at runtime
+#include "Core/ECS/ComponentArray.h"
+#include "Core/ECS/EntityManager.h"
+#include "Core/ECS/EntitySet.h"
+#include "Core/Interfaces/Serializable.h"
+#include "Core/Rollback/SnapshotIndex.h"
+#include "Core/Rollback/SnapshotKeyframe.h"
+#include "Core/Utility/SnapshotArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+//! Compile-time ID and signature of a component type plus the type-erasable operations used by the ECSCoordinator table
 template <typename T = IComponent>
 class ComponentTraits
 {
 public:
+  //! ID of the component, its position in ComponentTypes
+  static constexpr size_t ID = ComponentID<T>;
+
   //! Static getter
   static ComponentTraits& Get()
   {
@@ -14,114 +31,186 @@ public:
     return t;
   }
   //! Gets the signature for this component type
-  const std::bitset<MAX_COMPONENTS>& GetSignature() { return _signature; }
+  const std::bitset<MAX_COMPONENTS>& GetSignature() const { return _signature; }
+
+  //! Adds the component to the entity by ID
+  static void AddSelf(EntityID entity);
+  //! Removes the component from the entity by ID
+  static void RemoveSelf(EntityID entity);
+  //! Writes component data if it is serializable
+  static void Serialize(EntityID entity, std::ostream& os);
+  //! Reads component data if it is serializable
+  static void Deserialize(EntityID entity, std::istream& is);
+  //! Writes the snapshot run of every component in the array owned by one of the entities (trivial snapshots only).
+  //! With a keyframe, runs that match the keyframe's are left out. If nothing has been marked clean since the
+  //! keyframe was taken, useDirty skips comparing the components that haven't been touched. With an index, every run
+  //! is marked as a section of its owner so a mismatch points at the entity
+  static void SerializeArray(SnapshotWriter& writer, const EntitySet& entities, const SnapshotKeyframe* keyframe, bool useDirty, SnapshotIndex* index);
+  //! Marks every component of the type clean
+  static void ClearDirty();
+  //! Reads back what SerializeArray wrote into the components of the same entities, or of the entities they were
+  //! loaded as. Components that no longer exist are skipped
+  static void DeserializeArray(SnapshotReader& reader, const EntityRemap& remap);
+  //! Gets log information for the component if it is serializable
+  static std::string LogSelf(EntityID entity);
+  //! Gets the name of the component type
+  static const char* Name() { return typeid(T).name(); }
 
 private:
-  //! Initializes component ID and signature using ECSCoordinator
-  ComponentTraits();
-
-  //! returns a deleter function when being called from entity wrapper
-  const std::function<void()> AddSelf(EntityID entity);
-  const void RemoveSelf(EntityID entity);
-  const void CopyDataFromEntity(EntityID entity, SBuffer& buffer);
-  const void CopyDataToEntity(EntityID entity, const SBuffer& buffer);
-  const void Serialize(EntityID entity, std::ostream& os);
-  const void Deserialize(EntityID entity, std::istream& is);
-  const std::string LogSelf(EntityID entity);
-
-  int _ID = 0;
-  std::bitset<MAX_COMPONENTS> _signature;
-
-  /*static const SBuffer& CopyDataToBuffer(const T& item)
-  {
-    std::iostream stream(std::iostream::binary);
-    item.Serialize(stream);
-
-    return SBuffer(std::istreambuf_iterator<char>(stream), {});
-  }
-
-  static const void CopyDataIntoComponent(T& item, const SBuffer& buffer)
-  {
-    std::iostream stream(std::iostream::binary);
-    stream.write(buffer.data(), buffer.size());
+  ComponentTraits() { _signature.set(ID); }
 
-    item.Deserialize(stream);
-  }*/
+  std::bitset<MAX_COMPONENTS> _signature;
 
 };
 
 template <typename T>
-inline ComponentTraits<T>::ComponentTraits()
-{
-  _signature = ECSCoordinator::Get().RegisterComponent(_ID,
-  {
-    std::function<std::function<void()>(EntityID)>([this](EntityID e) { return AddSelf(e); }),
-    std::function<void(EntityID)>([this](EntityID e) { RemoveSelf(e); }),
-    std::function<void(EntityID, std::ostream&)>([this](EntityID e, std::ostream& os) { Serialize(e, os); }),
-    std::function<void(EntityID, std::istream&)>([this](EntityID e, std::istream& is) { Deserialize(e, is); }),
-    std::function<std::string(EntityID)>([this](EntityID e) { return LogSelf(e); }),
-    //std::function<SBuffer(EntityID)>([](EntityID e) { SBuffer buffer; CopyDataFromEntity(e, buffer); return buffer; }),
-    //std::function<void(EntityID, const SBuffer&)>([](EntityID e, const SBuffer& b) { CopyDataToEntity(e, b); }),
-    std::type_index(typeid(T))
-  });
-}
-
-template <typename T>
-const std::function<void()> ComponentTraits<T>::AddSelf(EntityID entity)
+void ComponentTraits<T>::AddSelf(EntityID entity)
 {
   ComponentArray<T>::Get().Insert(entity, T());
 
-  auto signature = EntityManager::Get().GetSignature(entity);
-  signature |= GetSignature();
-  EntityManager::Get().SetSignature(entity, signature);
-
-  return [entity]() { ComponentTraits<T>::Get().RemoveSelf(entity); };
+  EntityManager::Get().SetComponentBit(entity, ID, true);
 }
 
 template <typename T>
-const void ComponentTraits<T>::RemoveSelf(EntityID entity)
+void ComponentTraits<T>::RemoveSelf(EntityID entity)
 {
   ComponentArray<T>::Get().Remove(entity);
 
-  auto signature = EntityManager::Get().GetSignature(entity);
-  signature &= ~GetSignature();
-  EntityManager::Get().SetSignature(entity, signature);
+  EntityManager::Get().SetComponentBit(entity, ID, false);
 }
 
 template <typename T>
-const void ComponentTraits<T>::CopyDataFromEntity(EntityID entity, SBuffer& buffer)
+void ComponentTraits<T>::Serialize(EntityID entity, std::ostream& os)
 {
-  if constexpr (std::is_base_of_v<ISerializable, T>)
-    buffer = CopyDataToBuffer(ComponentArray<T>::Get().GetComponent(entity));
+  if constexpr (TrivialSnapshot<T>::value)
+  {
+    const T& component = ComponentArray<T>::Get().GetComponent(entity);
+    os.write(reinterpret_cast<const char*>(&component) + TrivialSnapshot<T>::Offset(component), TrivialSnapshot<T>::Size(component));
+  }
+  else if constexpr (std::is_base_of_v<ISerializable, T>)
+    ComponentArray<T>::Get().GetComponent(entity).Serialize(os);
 }
 
 template <typename T>
-const void ComponentTraits<T>::CopyDataToEntity(EntityID entity, const SBuffer& buffer)
+void ComponentTraits<T>::Deserialize(EntityID entity, std::istream& is)
 {
-  if constexpr (std::is_base_of_v<ISerializable, T>)
-    CopyDataIntoComponent(ComponentArray<T>::Get().GetComponent(entity), buffer);
+  if constexpr (TrivialSnapshot<T>::value)
+  {
+    T& component = ComponentArray<T>::Get().GetComponent(entity);
+    is.read(reinterpret_cast<char*>(&component) + TrivialSnapshot<T>::Offset(component), TrivialSnapshot<T>::Size(component));
+  }
+  else if constexpr (std::is_base_of_v<ISerializable, T>)
+    ComponentArray<T>::Get().GetComponent(entity).Deserialize(is);
 }
 
+template <typename T>
+void ComponentTraits<T>::SerializeArray(SnapshotWriter& writer, const EntitySet& entities, const SnapshotKeyframe* keyframe, bool useDirty, SnapshotIndex* index)
+{
+  if constexpr (TrivialSnapshot<T>::value)
+  {
+    // read through const so that writing the snapshot doesn't mark anything dirty
+    const ComponentArray<T>& array = ComponentArray<T>::Get();
+    const size_t offset = array.Size() > 0 ? TrivialSnapshot<T>::Offset(array.ComponentAt(0)) : 0;
+    const size_t size = array.Size() > 0 ? TrivialSnapshot<T>::Size(array.ComponentAt(0)) : 0;
+
+    auto written = [&](uint32_t index)
+    {
+      if (!entities.contains(array.EntityAt(index)))
+        return false;
+      if (!keyframe)
+        return true;
+      const char* reference = keyframe->FindRun(static_cast<int>(ID), array.EntityAt(index));
+      if (!reference)
+        return true;
+      // a component nothing has touched since the keyframe still matches it
+      if (useDirty && !array.IsDirty(index))
+        return false;
+      return std::memcmp(reference, reinterpret_cast<const char*>(&array.ComponentAt(index)) + offset, size) != 0;
+    };
+
+    // packed indices of the components to write, kept between snapshots for its memory
+    thread_local std::vector<uint32_t> indices;
+    indices.clear();
+    for (uint32_t i = 0; i < array.Size(); i++)
+    {
+      if (written(i))
+        indices.push_back(i);
+    }
+
+    const uint32_t count = static_cast<uint32_t>(indices.size());
+    std::memcpy(writer.Claim(sizeof(count)), &count, sizeof(count));
+    if (count == 0)
+      return;
+
+    // every run of a type is the same size, so the owners go first and the runs are packed after them. Claimed in one go,
+    // a second claim could grow the arena and move the first one
+    char* owners = writer.Claim(count * (sizeof(EntityID) + size));
+    char* runs = owners + count * sizeof(EntityID);
+    size_t runOffset = static_cast<size_t>(runs - writer.Data());
+    for (const uint32_t i : indices)
+    {
+      const EntityID entity = array.EntityAt(i);
+      std::memcpy(owners, &entity, sizeof(EntityID));
+      std::memcpy(runs, reinterpret_cast<const char*>(&array.ComponentAt(i)) + offset, size);
+      if (index)
+        index->Mark(runOffset, entity, static_cast<int>(ID));
+      owners += sizeof(EntityID);
+      runs += size;
+      runOffset += size;
+    }
+  }
+}
 
 template <typename T>
-const void ComponentTraits<T>::Serialize(EntityID entity, std::ostream& os)
+void ComponentTraits<T>::ClearDirty()
 {
-  if constexpr (std::is_base_of_v<ISerializable, T>)
-    ComponentArray<T>::Get().GetComponent(entity).Serialize(os);
+  if constexpr (TrivialSnapshot<T>::value)
+    ComponentArray<T>::Get().ClearDirty();
 }
 
 template <typename T>
-const void ComponentTraits<T>::Deserialize(EntityID entity, std::istream& is)
+void ComponentTraits<T>::DeserializeArray(SnapshotReader& reader, const EntityRemap& remap)
 {
-  if constexpr (std::is_base_of_v<ISerializable, T>)
-    ComponentArray<T>::Get().GetComponent(entity).Deserialize(is);
+  if constexpr (TrivialSnapshot<T>::value)
+  {
+    uint32_t count = 0;
+    const char* header = reader.Consume(sizeof(count));
+    if (!header)
+      return;
+    std::memcpy(&count, header, sizeof(count));
+    if (count == 0)
+      return;
+
+    ComponentArray<T>& array = ComponentArray<T>::Get();
+    // the runs have to be skipped even if none of their components exist anymore, so the size comes from a throwaway
+    // instance rather than the array
+    static const size_t size = TrivialSnapshot<T>::Size(T());
+    const char* owners = reader.Consume(count * sizeof(EntityID));
+    const char* runs = owners ? reader.Consume(count * size) : nullptr;
+    if (!runs)
+      return;
+
+    for (uint32_t i = 0; i < count; i++, owners += sizeof(EntityID), runs += size)
+    {
+      EntityID entity = 0;
+      std::memcpy(&entity, owners, sizeof(EntityID));
+      auto renamed = std::find_if(remap.begin(), remap.end(), [entity](const auto& pair) { return pair.first == entity; });
+      if (renamed != remap.end())
+        entity = renamed->second;
+
+      if (array.HasComponent(entity))
+      {
+        T& component = array.GetComponent(entity);
+        std::memcpy(reinterpret_cast<char*>(&component) + TrivialSnapshot<T>::Offset(component), runs, size);
+      }
+    }
+  }
 }
 
 template <typename T>
-const std::string ComponentTraits<T>::LogSelf(EntityID entity)
+std::string ComponentTraits<T>::LogSelf(EntityID entity)
 {
   if constexpr (std::is_base_of_v<ISerializable, T>)
     return ComponentArray<T>::Get().GetComponent(entity).Log();
   else return "";
 }
-
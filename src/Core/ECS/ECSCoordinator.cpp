@@ -1,53 +1,69 @@
 #include "Core/ECS/ECSCoordinator.h"
-#include "Core/ECS/Entity.h"
+#include "Core/ECS/ComponentTraits.h"
 
-//______________________________________________________________________________
-std::bitset<MAX_COMPONENTS> ECSCoordinator::RegisterComponent(int& id, ComponentEntityFnSet fnSet)
-{
-  // Generate component look up ID
-  id = NextID();
-  // Set runtime add, remove, serialize functions for this component
-  _serializationHelpers[id] = fnSet;
+// every type in ComponentTypes has to be complete here to generate the function table
+#include "Components/AIComponent.h"
+#include "Components/ActionComponents.h"
+#include "Components/Animator.h"
+#include "Components/Camera.h"
+#include "Components/Collider.h"
+#include "Components/Hitbox.h"
+#include "Components/Hurtbox.h"
+#include "Components/Input.h"
+#include "Components/MetaGameComponents.h"
+#include "Components/RenderComponent.h"
+#include "Components/Rigidbody.h"
+#include "Components/SFXComponent.h"
+#include "Components/StateComponent.h"
+#include "Components/Transform.h"
+#include "Components/UIComponents.h"
+#include "Components/Actors/CutsceneActor.h"
+#include "Components/Actors/GameActor.h"
+#include "Components/StateComponents/AttackStateComponent.h"
+#include "Components/StateComponents/HitStateComponent.h"
+#include "Components/StaticComponents/AttackLinkMap.h"
+#include "Systems/DestroyEntitiesSystem.h"
+#include "Systems/MenuSystem.h"
+#include "Systems/MoveSystem.h"
+#include "Systems/TimerSystem/TimerContainer.h"
+#include "Rendering/GLTexture.h"
 
-  // return generated signature
-  std::bitset<MAX_COMPONENTS> signature;
-  signature.set(id);
-  return signature;
-}
-
-//______________________________________________________________________________
-std::function<void()> ECSCoordinator::AddSelf(EntityID entity, int componentID)
-{
-  return _serializationHelpers[componentID].AddSelf(entity);
-}
-
-//______________________________________________________________________________
-void ECSCoordinator::RemoveSelf(EntityID entity, int componentID)
+namespace
 {
-  _serializationHelpers[componentID].RemoveSelf(entity);
-}
+  //______________________________________________________________________________
+  template <typename T>
+  constexpr ComponentEntityFnSet MakeFnSet()
+  {
+    return ComponentEntityFnSet{
+      &ComponentTraits<T>::AddSelf,
+      &ComponentTraits<T>::RemoveSelf,
+      &ComponentTraits<T>::Serialize,
+      &ComponentTraits<T>::Deserialize,
+      &ComponentTraits<T>::SerializeArray,
+      &ComponentTraits<T>::DeserializeArray,
+      &ComponentTraits<T>::ClearDirty,
+      &ComponentTraits<T>::LogSelf,
+      &ComponentTraits<T>::Name
+    };
+  }
 
+  //______________________________________________________________________________
+  template <typename ... T>
+  constexpr std::array<ComponentEntityFnSet, sizeof...(T)> MakeFnTable(type_list<T...>)
+  {
+    return { MakeFnSet<T>()... };
+  }
 
-std::string ECSCoordinator::LogData(EntityID entity, int componentID)
-{
-  return _serializationHelpers[componentID].LogSelf(entity);
+  //______________________________________________________________________________
+  template <typename ... T>
+  ComponentBitFlag MakeTrivialSnapshotSignature(type_list<T...>)
+  {
+    ComponentBitFlag signature;
+    (signature.set(ComponentID<T>, TrivialSnapshot<T>::value), ...);
+    return signature;
+  }
 }
 
 //______________________________________________________________________________
-/*void ECSCoordinator::CopyComponentData(EntityID original, EntityID newEntity, int componentID)
-{
-  SBuffer buffer = _serializationHelpers[componentID].CopyDataToBuffer(original);
-  _serializationHelpers[componentID].CopyFromBuffer(newEntity, buffer);
-}*/
-
-//______________________________________________________________________________
-int ECSCoordinator::NextID()
-{
-  static int ID = 0;
-
-  int rValue = ID++;
-
-  // update our number of registered components on each generation
-  ECSGlobalStatus::NRegisteredComponents = rValue;
-  return rValue;
-}
+const std::array<ComponentEntityFnSet, NComponents> ECSCoordinator::_fnTable = MakeFnTable(ComponentTypes{});
+const ComponentBitFlag ECSCoordinator::_trivialSnapshots = MakeTrivialSnapshotSignature(ComponentTypes{});
@@ -1,29 +1,44 @@
 #pragma once
 #include "Globals.h"
+#include "Core/ECS/ComponentList.h"
+#include "Core/ECS/EntityManager.h"
 #include "Core/Interfaces/Serializable.h"
 
 #include <bitset>
-#include <functional>
-#include <typeindex>
 #include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 class Entity;
+class EntitySet;
+class SnapshotKeyframe;
+class SnapshotIndex;
+class SnapshotWriter;
+class SnapshotReader;
 
+//! Entities a snapshot was saved with and the entities they were loaded as, for the ones that had to be recreated
+using EntityRemap = std::vector<std::pair<EntityID, EntityID>>;
+
+//______________________________________________________________________________
+//! Type-erased operations for one component type. Plain function pointers so a call is a single indirect jump
 struct ComponentEntityFnSet
 {
-  std::function<std::function<void()>(EntityID)> AddSelf;
-  std::function<void(EntityID)> RemoveSelf;
-  std::function<void(EntityID, std::ostream&)> SerializeSelf;
-  std::function<void(EntityID, std::istream&)> DeserializeSelf;
-  std::function<std::string(EntityID)> LogSelf;
-  //std::function<SBuffer(EntityID)> CopyDataToBuffer;
-  //std::function<void(EntityID, const SBuffer&)> CopyFromBuffer;
-  std::type_index typeIndex = typeid(int);
+  void (*AddSelf)(EntityID);
+  void (*RemoveSelf)(EntityID);
+  void (*SerializeSelf)(EntityID, std::ostream&);
+  void (*DeserializeSelf)(EntityID, std::istream&);
+  void (*SerializeArray)(SnapshotWriter&, const EntitySet&, const SnapshotKeyframe*, bool, SnapshotIndex*);
+  void (*DeserializeArray)(SnapshotReader&, const EntityRemap&);
+  void (*ClearDirty)();
+  std::string (*LogSelf)(EntityID);
+  const char* (*Name)();
 
 };
 
 //______________________________________________________________________________
-//! Maps components to add/remove and serialization functions at runtime (ID map is based on order of initialization of components)
+//! Maps component IDs to add/remove and serialization functions. The table is generated at compile time from ComponentTypes
 class ECSCoordinator
 {
 public:
@@ -34,30 +49,37 @@ public:
     return manager;
   }
 
-  //! Generate bit flag for component (used on ComponentTraits initialization), set function map
-  std::bitset<MAX_COMPONENTS> RegisterComponent(int& id, ComponentEntityFnSet fnSet);
-  //! Adds component mapped to ID to the entity and returns a removal function for it
-  std::function<void()> AddSelf(EntityID entity, int componentID);
+  //! Adds component mapped to ID to the entity
+  void AddSelf(EntityID entity, size_t componentID) { _fnTable[componentID].AddSelf(entity); }
   //! Removes component mapped to ID from the entity
-  void RemoveSelf(EntityID entity, int componentID);
-  //! Gets the type index of the component ID so that entity can look it up via deleter functions
-  std::type_index GetTypeIndex(int componentID) { return _serializationHelpers[componentID].typeIndex; }
+  void RemoveSelf(EntityID entity, size_t componentID) { _fnTable[componentID].RemoveSelf(entity); }
   //! Serializes component data to stream if entity has component and if it is serializable
-  void SerializeComponent(EntityID entity, std::ostream& os, int componentID) { _serializationHelpers[componentID].SerializeSelf(entity, os); }
+  void SerializeComponent(EntityID entity, std::ostream& os, size_t componentID) { _fnTable[componentID].SerializeSelf(entity, os); }
   //! Deserializes component data from stream if entity has comp and if it is serializable
-  void DeserializeComponent(EntityID entity, std::istream& is, int componentID) { _serializationHelpers[componentID].DeserializeSelf(entity, is); }
+  void DeserializeComponent(EntityID entity, std::istream& is, size_t componentID) { _fnTable[componentID].DeserializeSelf(entity, is); }
+  //! Components whose snapshot is a plain run of bytes. Their whole array is written at once by SerializeComponentArray
+  //! instead of entity by entity
+  const ComponentBitFlag& TrivialSnapshotComponents() const { return _trivialSnapshots; }
+  //! Writes the components of the type owned by the entities in one go (trivial snapshots only). With a keyframe only
+  //! the components that differ from it are written. With an index, each component's run gets a section of its owner
+  void SerializeComponentArray(size_t componentID, SnapshotWriter& writer, const EntitySet& entities, const SnapshotKeyframe* keyframe = nullptr,
+    bool useDirty = false, SnapshotIndex* index = nullptr)
+  {
+    _fnTable[componentID].SerializeArray(writer, entities, keyframe, useDirty, index);
+  }
+  //! Reads back a component array written by SerializeComponentArray
+  void DeserializeComponentArray(size_t componentID, SnapshotReader& reader, const EntityRemap& remap) { _fnTable[componentID].DeserializeArray(reader, remap); }
+  //! Marks every component of the type clean (see ComponentArray::IsDirty)
+  void ClearDirtyComponents(size_t componentID) { _fnTable[componentID].ClearDirty(); }
   //! Gets name of component at this componentID
-  std::string_view GetComponentName(int componentID) { return _serializationHelpers[componentID].typeIndex.name(); }
+  std::string_view GetComponentName(size_t componentID) { return _fnTable[componentID].Name(); }
   //! Gets log information for component
-  std::string LogData(EntityID entity, int componentID);
-
-  //!
-//void CopyComponentData(EntityID original, EntityID newEntity, int componentID);
+  std::string LogData(EntityID entity, size_t componentID) { return _fnTable[componentID].LogSelf(entity); }
 
 private:
-  //! Internal get next id for initializing component ID value
-  int NextID();
-  //! Map ID value (which will correspond to its location in the bit map)
-  std::array<ComponentEntityFnSet, MAX_COMPONENTS> _serializationHelpers;
+  //! Function table indexed by component ID (defined where all component types are complete)
+  static const std::array<ComponentEntityFnSet, NComponents> _fnTable;
+  //! Bits of the components with a TrivialSnapshot
+  static const ComponentBitFlag _trivialSnapshots;
 
 };
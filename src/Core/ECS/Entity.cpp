@@ -1,5 +1,8 @@
 #include "Core/ECS/Entity.h"
 #include "Core/ECS/EntityManager.h"
+#include "Core/ECS/SystemRegistry.h"
+#include "Core/ECS/EntityCommandBuffer.h"
+#include "Core/Rollback/SnapshotIndex.h"
 
 // for stupid scaling problem that still needs to be fixed
 #include "Components/Transform.h"
@@ -30,20 +33,22 @@ Entity::~Entity()
 }
 
 //______________________________________________________________________________
-void Entity::Serialize(std::ostream& os) const
+void Entity::Serialize(std::ostream& os, SnapshotIndex* index, const ComponentBitFlag& skipData) const
 {
   //std::stringstream serializationLog;
   //serializationLog << "SERIALIZING: \n";
 
   const ComponentBitFlag& signature = GetSignature();
   // serialize bitset first to know which components are attached to this one
-  os << signature;
+  Serializer<ComponentBitFlag>::Serialize(os, signature);
   // loop through signature finding all attached components
-  for (size_t compIndex = 0; compIndex < ECSGlobalStatus::NRegisteredComponents; compIndex++)
+  for (size_t compIndex = 0; compIndex < NComponents; compIndex++)
   {
-    if (signature.test(compIndex))
+    if (signature.test(compIndex) && !skipData.test(compIndex))
     {
       //serializationLog << ECSCoordinator::Get().GetComponentName(compIndex) << "\n";
+      if (index)
+        index->Mark(os, _id, static_cast<int>(compIndex));
       // write component data to stream based on signature
       ECSCoordinator::Get().SerializeComponent(_id, os, compIndex);
     }
@@ -54,41 +59,35 @@ void Entity::Serialize(std::ostream& os) const
 }
 
 //______________________________________________________________________________
-void Entity::Deserialize(std::istream& is)
+void Entity::Deserialize(std::istream& is, const ComponentBitFlag& skipData)
 {
   //std::stringstream serializationLog;
   //serializationLog << "DESERIALIZING: \n";
 
   ComponentBitFlag signature;
   // stream first thing should be signature
-  is >> signature;
+  Serializer<ComponentBitFlag>::Deserialize(is, signature);
+
+  // components currently attached before loading
+  const ComponentBitFlag attached = GetSignature();
 
-  for (size_t compIndex = 0; compIndex < ECSGlobalStatus::NRegisteredComponents; compIndex++)
+  for (size_t compIndex = 0; compIndex < NComponents; compIndex++)
   {
-    std::type_index compTypeIndex = ECSCoordinator::Get().GetTypeIndex(compIndex);
     if (signature.test(compIndex))
     {
       //serializationLog << ECSCoordinator::Get().GetComponentName(compIndex) << "\n";
 
-      // if deleter is already present, component already attached to entity
-      if (_deleteComponent.find(compTypeIndex) == _deleteComponent.end())
-      {
-        // add self via generator which needs to add deleter
-        auto deleterFn = ECSCoordinator::Get().AddSelf(GetID(), compIndex);
-        _deleteComponent.insert(std::make_pair(compTypeIndex, deleterFn));
-      }
+      // add self via generator if not already attached
+      if (!attached.test(compIndex))
+        ECSCoordinator::Get().AddSelf(GetID(), compIndex);
       // this should write data directly to component, so no need to do anything
-      ECSCoordinator::Get().DeserializeComponent(GetID(), is, compIndex);
+      if (!skipData.test(compIndex))
+        ECSCoordinator::Get().DeserializeComponent(GetID(), is, compIndex);
     }
-    else
+    else if (attached.test(compIndex))
     {
       // only delete if its already present
-      if (_deleteComponent.find(compTypeIndex) != _deleteComponent.end())
-      {
-        ECSCoordinator::Get().RemoveSelf(GetID(), compIndex);
-        // be sure to remove deleter when removing components through the generator
-        _deleteComponent.erase(compTypeIndex);
-      }
+      ECSCoordinator::Get().RemoveSelf(GetID(), compIndex);
     }
   }
   // set the new entity signature with all components registered
@@ -110,7 +109,7 @@ std::string Entity::Log()
   const ComponentBitFlag& signature = GetSignature();
   ss << signature << "\n";
 
-  for (size_t compIndex = 0; compIndex < ECSGlobalStatus::NRegisteredComponents; compIndex++)
+  for (size_t compIndex = 0; compIndex < NComponents; compIndex++)
   {
     if (signature.test(compIndex))
     {
@@ -142,9 +141,11 @@ void Entity::LoadEntitySnapshot(const SBuffer& snapshot)
 //______________________________________________________________________________
 void Entity::RemoveAllComponents()
 {
-  for(auto func : _deleteComponent)
+  const ComponentBitFlag signature = GetSignature();
+  for (size_t compIndex = 0; compIndex < NComponents; compIndex++)
   {
-    func.second();
+    if (signature.test(compIndex))
+      ECSCoordinator::Get().RemoveSelf(_id, compIndex);
   }
   CheckAgainstSystems(this);
 }
@@ -189,5 +190,9 @@ void Entity::SetScale(Vector2<float> scale)
 //______________________________________________________________________________
 void Entity::CheckAgainstSystems(Entity* entity)
 {
-  GameManager::Get().CheckAgainstSystems(entity);
+  // while deferred commands are being applied, hold off until all of them are done
+  if (EntityCommandBuffer::Get().Flushing())
+    EntityCommandBuffer::Get().MarkDirty(entity->GetID());
+  else
+    SystemRegistry::Get().CheckEntity(entity->GetID());
 }
@@ -12,6 +12,8 @@
 #include "Core/Math/Vector2.h"
 #include "Core/Utility/TypeTraits.h"
 
+class SnapshotIndex;
+
 //______________________________________________________________________________
 //! Entity is a wrapper for the connection between the entity manager and the component manager(s)
 class Entity : public std::enable_shared_from_this<Entity>, public ISerializable
@@ -23,9 +25,14 @@ public:
   ~Entity();
 
   //! Serializes JUST THE COMPONENTS
-  void Serialize(std::ostream& os) const override;
+  void Serialize(std::ostream& os) const override { Serialize(os, nullptr, ComponentBitFlag()); }
+  //! Serializes as above, starting a section in the index (if any) for each component written. The signature still
+  //! lists the components in skipData, but their data is left for the caller to write
+  void Serialize(std::ostream& os, SnapshotIndex* index, const ComponentBitFlag& skipData) const;
   //! Deserializes JUST THE COMPONENTS
-  void Deserialize(std::istream& is) override;
+  void Deserialize(std::istream& is) override { Deserialize(is, ComponentBitFlag()); }
+  //! Deserializes what Serialize wrote with the same skipData. Those components are attached but their data isn't read
+  void Deserialize(std::istream& is, const ComponentBitFlag& skipData);
   //!
   std::string Log() override;
 
@@ -67,9 +74,6 @@ public:
   void RemoveComponents();
 
 protected:
-  //! Don't remove deletion function here. This is used for removing components internally if we do not know the type
-  template <typename T = IComponent>
-  void RemoveComponentInternal();
   //! Add component of type specified type to the entity without calling check against systems
   template <typename T = IComponent>
   void AddComponentNoSystemCheck();
@@ -77,14 +81,12 @@ protected:
   template <typename T = IComponent>
   void RemoveComponentNoSystemCheck();
 
-  //! Checks against all existing systems (currently hardcoded in the game manager)
+  //! Checks against the systems whose required components changed since the last check
   static void CheckAgainstSystems(Entity* entity);
 
 
   //! Protected Members
 
-  //! Functors for deleting components en masse (without knowing type at runtime) uses RemoveComponentInternal
-  std::unordered_map<std::type_index, std::function<void()>> _deleteComponent;
   //! This entity ID (and order of creation)
   EntityID _id;
 
@@ -107,12 +109,7 @@ inline void Entity::AddComponent()
   {
     ComponentArray<T>::Get().Insert(_id, T());
 
-    auto signature = GetSignature();
-    signature |= ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
-
-    // add to special deleter list
-    _deleteComponent.insert(std::make_pair(std::type_index(typeid(T)), [this]() { RemoveComponentInternal<T>(); }));
+    EntityManager::Get().SetComponentBit(_id, ComponentTraits<T>::ID, true);
 
     // see if this needs to be added to the system
     CheckAgainstSystems(this);
@@ -128,12 +125,7 @@ inline void Entity::AddComponent(const ComponentInitParams<T>& initParams)
     ComponentArray<T>::Get().Insert(_id, T());
     ComponentInitParams<T>::Init(ComponentArray<T>::Get().GetComponent(_id), initParams);
 
-    auto signature = GetSignature();
-    signature |= ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
-
-    // add to special deleter list
-    _deleteComponent.insert(std::make_pair(std::type_index(typeid(T)), [this]() { RemoveComponentInternal<T>(); }));
+    EntityManager::Get().SetComponentBit(_id, ComponentTraits<T>::ID, true);
 
     // see if this needs to be added to the system
     CheckAgainstSystems(this);
@@ -150,11 +142,13 @@ template <typename T, typename ... Rest>
 inline void Entity::AddComponents()
 {
   // recursive control path enders
-  if (!all_base_of<IComponent, T, Rest...>() || std::is_same_v<T, IComponent>)
+  if constexpr (!AllComponents<T, Rest...> || std::is_same_v<T, IComponent>)
     return CheckAgainstSystems(this);
-
-  AddComponentNoSystemCheck<T>();
-  AddComponents<Rest...>();
+  else
+  {
+    AddComponentNoSystemCheck<T>();
+    AddComponents<Rest...>();
+  }
 }
 
 //______________________________________________________________________________
@@ -165,12 +159,7 @@ inline void Entity::RemoveComponent()
   {
     ComponentArray<T>::Get().Remove(_id);
 
-    auto signature = GetSignature();
-    signature &= ~ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
-
-    // remove from special deleter list
-    _deleteComponent.erase(std::type_index(typeid(T)));
+    EntityManager::Get().SetComponentBit(_id, ComponentTraits<T>::ID, false);
 
     CheckAgainstSystems(this);
   }
@@ -181,25 +170,13 @@ template <typename T, typename ... Rest>
 inline void Entity::RemoveComponents()
 {
   // recursive control path ender will check the system 
-  if (!all_base_of<IComponent, T, Rest...>() || std::is_same_v<T, IComponent>)
+  if constexpr (!AllComponents<T, Rest...> || std::is_same_v<T, IComponent>)
     return CheckAgainstSystems(this);
-
-  // use no system check here so it can be a little more efficient
-  RemoveComponentNoSystemCheck<T>();
-  RemoveComponents<Rest...>();
-}
-
-//______________________________________________________________________________
-template <typename T>
-inline void Entity::RemoveComponentInternal()
-{
-  if (ComponentArray<T>::Get().HasComponent(_id))
+  else
   {
-    ComponentArray<T>::Get().Remove(_id);
-
-    auto signature = GetSignature();
-    signature &= ~ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
+    // use no system check here so it can be a little more efficient
+    RemoveComponentNoSystemCheck<T>();
+    RemoveComponents<Rest...>();
   }
 }
 
@@ -211,12 +188,7 @@ inline void Entity::AddComponentNoSystemCheck()
   {
     ComponentArray<T>::Get().Insert(_id, T());
 
-    auto signature = GetSignature();
-    signature |= ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
-
-    // add to special deleter list
-    _deleteComponent.insert(std::make_pair(std::type_index(typeid(T)), [this]() { RemoveComponentInternal<T>(); }));
+    EntityManager::Get().SetComponentBit(_id, ComponentTraits<T>::ID, true);
   }
 }
 
@@ -228,11 +200,6 @@ inline void Entity::RemoveComponentNoSystemCheck()
   {
     ComponentArray<T>::Get().Remove(_id);
 
-    auto signature = GetSignature();
-    signature &= ~ComponentTraits<T>::Get().GetSignature();
-    EntityManager::Get().SetSignature(_id, signature);
-
-    // remove from special deleter list
-    _deleteComponent.erase(std::type_index(typeid(T)));
+    EntityManager::Get().SetComponentBit(_id, ComponentTraits<T>::ID, false);
   }
 }
@@ -0,0 +1,54 @@
+#include "Core/ECS/EntityCommandBuffer.h"
+#include "Core/ECS/SystemRegistry.h"
+
+//______________________________________________________________________________
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+  // commands never flushed still need their captures cleaned up
+  for (Command& command : _commands)
+    command.destroy(command.data);
+}
+
+//______________________________________________________________________________
+void EntityCommandBuffer::Flush()
+{
+  // a guard going out of scope inside of a command, the outer flush will pick up anything recorded
+  if (_flushing)
+    return;
+
+  _flushing = true;
+  // commands can record more commands while running, so the list can grow while being walked
+  for (size_t i = 0; i < _commands.size(); i++)
+  {
+    Command command = _commands[i];
+    command.execute(command.data);
+    command.destroy(command.data);
+  }
+  _commands.clear();
+  _currentBlock = 0;
+  _blockOffset = 0;
+  _flushing = false;
+
+  // only now update system membership, once per entity with the merged signature change
+  for (EntityID entity : _dirtyEntities)
+    SystemRegistry::Get().CheckEntity(entity);
+  _dirtyEntities.clear();
+}
+
+//______________________________________________________________________________
+void* EntityCommandBuffer::Allocate(size_t size, size_t alignment)
+{
+  size_t offset = (_blockOffset + alignment - 1) & ~(alignment - 1);
+  if (_blocks.empty() || offset + size > BlockSize)
+  {
+    // move to the next block, reusing blocks from previous frames when possible
+    if (!_blocks.empty())
+      _currentBlock++;
+    if (_currentBlock >= _blocks.size())
+      _blocks.emplace_back(new unsigned char[BlockSize]);
+    offset = 0;
+  }
+
+  _blockOffset = offset + size;
+  return _blocks[_currentBlock].get() + offset;
+}
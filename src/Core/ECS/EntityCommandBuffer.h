@@ -0,0 +1,154 @@
+#pragma once
+#include "Core/ECS/ComponentArray.h"
+#include "Core/ECS/EntityManager.h"
+#include "Core/ECS/ComponentTraits.h"
+#include "Core/ECS/EntitySet.h"
+
+#include <memory>
+#include <new>
+#include <vector>
+
+//______________________________________________________________________________
+//! Records structural changes (component add/remove/init and arbitrary deferred calls) so they can be applied
+//! together at a sync point. Commands are stored in reusable blocks (no per-command heap allocation) and while
+//! the buffer is being flushed, system checks are collected per entity and ran once after all commands are applied
+class EntityCommandBuffer
+{
+public:
+  //! Static getter
+  static EntityCommandBuffer& Get()
+  {
+    static EntityCommandBuffer buffer;
+    return buffer;
+  }
+
+  //! Records adding the component to the entity. Typed commands hold a handle and are skipped if the entity is
+  //! destroyed before the flush
+  template <typename T>
+  void AddComponent(EntityID entity);
+  //! Records adding the component to the entity and initializing it (reinitializes if already attached)
+  template <typename T>
+  void AddComponent(EntityID entity, const ComponentInitParams<T>& initParams);
+  //! Records removing the component from the entity
+  template <typename T>
+  void RemoveComponent(EntityID entity);
+  //! Records an arbitrary callable to be ran at the next flush
+  template <typename Fn>
+  void Run(Fn&& fn);
+
+  //! Applies all recorded commands in the order recorded, then checks every touched entity against systems once
+  void Flush();
+  //! Whether the commands are currently being applied. Structural changes made now only mark the entity
+  bool Flushing() const { return _flushing; }
+  //! Marks entity as needing a system check at the end of the flush
+  void MarkDirty(EntityID entity) { if (entity < EntityManager::Get().IDRange()) _dirtyEntities.insert(entity); }
+
+private:
+  EntityCommandBuffer() = default;
+  ~EntityCommandBuffer();
+  EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+  EntityCommandBuffer(EntityCommandBuffer&&) = delete;
+  EntityCommandBuffer operator=(const EntityCommandBuffer&) = delete;
+  EntityCommandBuffer operator=(EntityCommandBuffer&&) = delete;
+
+  struct Command
+  {
+    //! Runs the stored callable
+    void (*execute)(void*);
+    //! Destroys the stored callable
+    void (*destroy)(void*);
+    //! Location of the callable in the block storage
+    void* data;
+  };
+
+  //! Gets memory for a command from the block storage. Blocks never move so commands can be recorded while flushing
+  void* Allocate(size_t size, size_t alignment);
+
+  //! Size of each block of command storage
+  static constexpr size_t BlockSize = 4096;
+
+  //! Commands in the order they were recorded
+  std::vector<Command> _commands;
+  //! Storage for the recorded callables. Kept between flushes so they are allocated once
+  std::vector<std::unique_ptr<unsigned char[]>> _blocks;
+  //! Block currently being allocated from
+  size_t _currentBlock = 0;
+  //! Offset of the next free byte in the current block
+  size_t _blockOffset = 0;
+  //! Entities whose signature changed during the flush
+  EntitySet _dirtyEntities;
+  //! Set while commands are being applied
+  bool _flushing = false;
+
+};
+
+//______________________________________________________________________________
+template <typename T>
+inline void EntityCommandBuffer::AddComponent(EntityID entity)
+{
+  Run([handle = EntityManager::Get().GetHandle(entity)]()
+  {
+    const EntityID entity = handle.id;
+    if (!EntityManager::Get().IsAlive(handle))
+      return;
+    if (!ComponentArray<T>::Get().HasComponent(entity))
+    {
+      ComponentArray<T>::Get().Insert(entity, T());
+      EntityManager::Get().SetComponentBit(entity, ComponentTraits<T>::ID, true);
+      EntityCommandBuffer::Get().MarkDirty(entity);
+    }
+  });
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline void EntityCommandBuffer::AddComponent(EntityID entity, const ComponentInitParams<T>& initParams)
+{
+  Run([handle = EntityManager::Get().GetHandle(entity), initParams]()
+  {
+    const EntityID entity = handle.id;
+    if (!EntityManager::Get().IsAlive(handle))
+      return;
+    if (!ComponentArray<T>::Get().HasComponent(entity))
+    {
+      ComponentArray<T>::Get().Insert(entity, T());
+      EntityManager::Get().SetComponentBit(entity, ComponentTraits<T>::ID, true);
+      EntityCommandBuffer::Get().MarkDirty(entity);
+    }
+    ComponentInitParams<T>::Init(ComponentArray<T>::Get().GetComponent(entity), initParams);
+  });
+}
+
+//______________________________________________________________________________
+template <typename T>
+inline void EntityCommandBuffer::RemoveComponent(EntityID entity)
+{
+  Run([handle = EntityManager::Get().GetHandle(entity)]()
+  {
+    const EntityID entity = handle.id;
+    if (!EntityManager::Get().IsAlive(handle))
+      return;
+    if (ComponentArray<T>::Get().HasComponent(entity))
+    {
+      ComponentArray<T>::Get().Remove(entity);
+      EntityManager::Get().SetComponentBit(entity, ComponentTraits<T>::ID, false);
+      EntityCommandBuffer::Get().MarkDirty(entity);
+    }
+  });
+}
+
+//______________________________________________________________________________
+template <typename Fn>
+inline void EntityCommandBuffer::Run(Fn&& fn)
+{
+  using Callable = std::decay_t<Fn>;
+  static_assert(sizeof(Callable) <= BlockSize, "Deferred callable is too large for the command buffer");
+
+  void* data = Allocate(sizeof(Callable), alignof(Callable));
+  new (data) Callable(std::forward<Fn>(fn));
+
+  _commands.push_back(Command{
+    [](void* callable) { (*static_cast<Callable*>(callable))(); },
+    [](void* callable) { static_cast<Callable*>(callable)->~Callable(); },
+    data });
+}
@@ -1,24 +1,37 @@
 #include "Core/ECS/EntityManager.h"
 #include "Core/ECS/ECSCoordinator.h"
 
+#include <algorithm>
+
 EntityID EntityManager::RegisterEntity()
 {
-  if (_livingEntityCount < MAX_ENTITIES)
+  if (_livingEntityCount < _maxEntities)
   {
+    _livingEntityCount++;
+    // hand out fresh ids first, then the oldest destroyed one
+    if (_signatures.size() < _maxEntities)
+    {
+      _signatures.emplace_back();
+      _generations.push_back(0);
+      _alive.push_back(true);
+      return static_cast<EntityID>(_signatures.size() - 1);
+    }
     EntityID id = _availableEntities.front();
     _availableEntities.pop();
-    _livingEntityCount++;
+    _alive[id] = true;
     return id;
   }
-  return MAX_ENTITIES;
+  return InvalidEntity;
 }
 
 void EntityManager::DestroyEntity(EntityID id)
 {
-  if (id < MAX_ENTITIES)
+  if (id < _signatures.size() && _alive[id])
   {
-    // invalidate signature of destroyed entity
+    // invalidate signature of destroyed entity and any handles to it
     _signatures[id].reset();
+    _generations[id]++;
+    _alive[id] = false;
 
     // destroy id at the back of queue as it is newly available
     _availableEntities.push(id);
@@ -28,7 +41,7 @@ void EntityManager::DestroyEntity(EntityID id)
 
 void EntityManager::SetSignature(EntityID id, ComponentBitFlag signature)
 {
-  if (id < MAX_ENTITIES)
+  if (id < _signatures.size())
   {
     _signatures[id] = signature;
   }
@@ -36,13 +49,15 @@ void EntityManager::SetSignature(EntityID id, ComponentBitFlag signature)
 
 ComponentBitFlag EntityManager::GetSignature(EntityID id)
 {
-  assert(id < MAX_ENTITIES && "Entity out of range.");
+  assert(id < _signatures.size() && "Entity out of range.");
   return _signatures[id];
 }
 
-EntityManager::EntityManager() : _livingEntityCount(0)
+void EntityManager::SetMaxEntities(EntityID maxEntities)
 {
+  _maxEntities = std::max(maxEntities, IDRange());
+}
 
-  for (EntityID entity = 0; entity < MAX_ENTITIES; entity++)
-    _availableEntities.push(entity);
+EntityManager::EntityManager() : _maxEntities(DEFAULT_MAX_ENTITIES), _livingEntityCount(0)
+{
 }
@@ -1,17 +1,65 @@
 #pragma once
 #include <queue>
-#include <array>
+#include <vector>
 #include <bitset>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 
 #include "Globals.h"
+#include "Core/Interfaces/Serializable.h"
 
 //! Bit flag for the components currently attached
 using ComponentBitFlag = std::bitset<MAX_COMPONENTS>;
 
+//______________________________________________________________________________
+//! Writes the signature as 64 bit words (16 bytes for 128 components) instead of the one character per bit that
+//! operator<< writes for a bitset
+template <> struct Serializer<ComponentBitFlag>
+{
+  static constexpr size_t Words = (MAX_COMPONENTS + 63) / 64;
+
+  static void Serialize(std::ostream& os, const ComponentBitFlag& item)
+  {
+    const ComponentBitFlag lowWord(~0ULL);
+    uint64_t words[Words];
+    for (size_t i = 0; i < Words; i++)
+      words[i] = ((item >> (i * 64)) & lowWord).to_ullong();
+    os.write((const char*)words, sizeof(words));
+  }
+
+  static void Deserialize(std::istream& is, ComponentBitFlag& item)
+  {
+    uint64_t words[Words];
+    is.read((char*)words, sizeof(words));
+
+    item.reset();
+    for (size_t i = Words; i-- > 0;)
+    {
+      item <<= 64;
+      item |= ComponentBitFlag(words[i]);
+    }
+  }
+};
+
+//______________________________________________________________________________
+//! Entity ID plus the generation of its slot when the handle was made. The generation changes every time the ID is
+//! freed, so a handle that outlives its entity is detected as stale instead of aliasing whatever reuses the ID
+struct EntityHandle
+{
+  EntityID id;
+  uint32_t generation;
+
+  bool operator==(const EntityHandle& other) const { return id == other.id && generation == other.generation; }
+  bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
 class EntityManager
 {
 public:
+  //! ID returned when the entity cap has been reached
+  static constexpr EntityID InvalidEntity = std::numeric_limits<EntityID>::max();
+
   //! Get Singleton instance of the EntityManager
   static EntityManager& Get()
   {
@@ -26,9 +74,26 @@ public:
   void SetSignature(EntityID id, ComponentBitFlag signature);
   //! Get this entity's signature from the array
   ComponentBitFlag GetSignature(EntityID id);
+  //! Checks a single component bit of this entity's signature
+  bool HasComponentBit(EntityID id, size_t componentID) const { return id < _signatures.size() && _signatures[id].test(componentID); }
+  //! Sets or clears a single component bit of this entity's signature
+  void SetComponentBit(EntityID id, size_t componentID, bool value) { if (id < _signatures.size()) _signatures[id].set(componentID, value); }
+
+  //! Makes a handle to the entity in its current generation
+  EntityHandle GetHandle(EntityID id) const { return EntityHandle{ id, id < _generations.size() ? _generations[id] : 0 }; }
+  //! Checks the handle still refers to a living entity
+  bool IsAlive(const EntityHandle& handle) const { return handle.id < _generations.size() && _generations[handle.id] == handle.generation && _alive[handle.id]; }
+
+  //! Sets how many entities can be alive at once. Can't go below the number of IDs already handed out
+  void SetMaxEntities(EntityID maxEntities);
+  //! Max number of entities alive at once
+  EntityID GetMaxEntities() const { return _maxEntities; }
+  //! Every ID handed out so far is below this value
+  EntityID IDRange() const { return static_cast<EntityID>(_signatures.size()); }
+  //! Number of entities currently alive
+  uint32_t LivingEntityCount() const { return _livingEntityCount; }
 
 private:
-  //! initialize queue of available with all possible entity ids
   EntityManager();
 
   //! Delete any sort of copy for singleton
@@ -37,10 +102,16 @@ private:
   EntityManager operator=(const EntityManager&) = delete;
   EntityManager operator=(EntityManager&&) = delete;
 
-  //! queue of unused entity ids
+  //! queue of destroyed entity ids, reused once every fresh id up to the cap has been handed out
   std::queue<EntityID> _availableEntities;
-  //! array of signatures where index corresponds to entity id
-  std::array<ComponentBitFlag, MAX_ENTITIES> _signatures;
+  //! array of signatures where index corresponds to entity id (grows as ids are handed out)
+  std::vector<ComponentBitFlag> _signatures;
+  //! generation of each id, incremented when the id is freed
+  std::vector<uint32_t> _generations;
+  //! whether each id is currently handed out
+  std::vector<bool> _alive;
+  //! max number of ids handed out
+  EntityID _maxEntities;
   //! total living entities - used to keep limits on how many exist
   uint32_t _livingEntityCount;
 
@@ -0,0 +1,120 @@
+#pragma once
+#include "Globals.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+//______________________________________________________________________________
+//! Set of entity IDs stored as a bitset that grows to the highest ID inserted. Insert/erase are a single bit op,
+//! iteration walks the words linearly and always visits IDs in ascending order (same as std::set)
+class EntitySet
+{
+public:
+  using Word = uint64_t;
+  static constexpr size_t BitsPerWord = sizeof(Word) * 8;
+  //! Sentinel ID for the end iterator
+  static constexpr EntityID EndID = std::numeric_limits<EntityID>::max();
+
+  //! Forward iterator over the set bits
+  class Iterator
+  {
+  public:
+    //! Constructs iterator at the first set bit, or the end iterator
+    Iterator(const EntitySet* set, bool atEnd) : _set(set)
+    {
+      if (!atEnd && !_set->_words.empty())
+      {
+        _remaining = _set->_words[0];
+        Advance();
+      }
+    }
+
+    EntityID operator*() const { return _current; }
+    Iterator& operator++() { Advance(); return *this; }
+    bool operator==(const Iterator& other) const { return _current == other._current; }
+    bool operator!=(const Iterator& other) const { return _current != other._current; }
+
+  private:
+    //! Moves to the next set bit. Only the word being scanned is cached, so bits changed in later words
+    //! during iteration are respected
+    void Advance()
+    {
+      while (_remaining == 0)
+      {
+        if (++_word >= _set->_words.size())
+        {
+          _current = EndID;
+          return;
+        }
+        _remaining = _set->_words[_word];
+      }
+      _current = static_cast<EntityID>(_word * BitsPerWord) + CountTrailingZeros(_remaining);
+      // clear lowest set bit
+      _remaining &= (_remaining - 1);
+    }
+
+    const EntitySet* _set;
+    size_t _word = 0;
+    Word _remaining = 0;
+    EntityID _current = EndID;
+  };
+
+  //! Adds the entity to the set
+  void insert(EntityID entity)
+  {
+    const size_t wordIndex = entity / BitsPerWord;
+    if (wordIndex >= _words.size())
+      _words.resize(wordIndex + 1, 0);
+    Word& word = _words[wordIndex];
+    const Word mask = Word(1) << (entity % BitsPerWord);
+    _count += (word & mask) ? 0 : 1;
+    word |= mask;
+  }
+  //! Removes the entity from the set
+  void erase(EntityID entity)
+  {
+    const size_t wordIndex = entity / BitsPerWord;
+    if (wordIndex >= _words.size())
+      return;
+    Word& word = _words[wordIndex];
+    const Word mask = Word(1) << (entity % BitsPerWord);
+    _count -= (word & mask) ? 1 : 0;
+    word &= ~mask;
+  }
+  //! Checks if entity is in the set
+  bool contains(EntityID entity) const
+  {
+    const size_t wordIndex = entity / BitsPerWord;
+    return wordIndex < _words.size() && ((_words[wordIndex] >> (entity % BitsPerWord)) & Word(1));
+  }
+  //! Removes all entities (keeps the allocated words)
+  void clear() { std::fill(_words.begin(), _words.end(), 0); _count = 0; }
+  //! Number of entities in the set
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+
+  Iterator begin() const { return Iterator(this, false); }
+  Iterator end() const { return Iterator(this, true); }
+
+private:
+  static EntityID CountTrailingZeros(Word word)
+  {
+#ifdef _WIN32
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<EntityID>(index);
+#else
+    return static_cast<EntityID>(__builtin_ctzll(word));
+#endif
+  }
+
+  std::vector<Word> _words;
+  size_t _count = 0;
+
+};
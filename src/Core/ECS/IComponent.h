@@ -1,8 +1,12 @@
 #pragma once
 #include "Globals.h"
 
+#include <cassert>
+#include <cstddef>
 #include <memory>
 #include <bitset>
+#include <tuple>
+#include <type_traits>
 
 // IDEA: Split up components into their data and functions that change that data
 // Based on reducers in redux??
@@ -25,3 +29,76 @@ public:
   virtual void Draw() {}
   
 };
+
+//______________________________________________________________________________
+//! Base for marker components that carry no data. Tags are empty types (no vtable), so they only exist as a bit in the
+//! entity signature: no storage, no index maps and nothing to serialize
+struct ITag {};
+
+//! Whether the component is a tag, stored as a signature bit only
+template <typename T>
+constexpr bool IsTagComponent = std::is_empty_v<T>;
+
+//! Whether the type can be attached to an entity
+template <typename T>
+constexpr bool IsComponent = std::is_base_of_v<IComponent, T> || IsTagComponent<T>;
+
+//! Whether all of the types can be attached to an entity
+template <typename ... T>
+constexpr bool AllComponents = (IsComponent<T> && ...);
+
+//______________________________________________________________________________
+//! Whether the rollback state of the component is a run of plain data members, copied as raw bytes straight out of
+//! the component storage instead of going through Serialize. Opt in by specializing as TrivialSnapshotRange
+template <typename T>
+struct TrivialSnapshot : std::false_type {};
+
+//______________________________________________________________________________
+//! Type of the member pointed to by a pointer to member of T
+template <typename T, auto Member>
+using SnapshotMemberType = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const T&>().*Member)>>;
+
+//! Whether members with the sizes and alignments, laid out one after the other in declaration order, leave no padding
+//! between them. The run starts on a multiple of the first alignment, so that has to be the largest one
+template <size_t N>
+constexpr bool SnapshotRunPacked(const size_t (&sizes)[N], const size_t (&aligns)[N])
+{
+  size_t end = 0;
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (aligns[i] > aligns[0] || end % aligns[i] != 0)
+      return false;
+    end += sizes[i];
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+//! Snapshot of a run of members, listed in declaration order with none left out. The run is copied as one block of
+//! bytes, so every member in it has to be plain data and the members have to sit back to back with no padding in
+//! between, or the padding would go into the snapshot and checksums. The vtable pointers sit before the run, so the
+//! bytes are the same in every process
+template <typename T, auto First, auto ... Rest>
+struct TrivialSnapshotRange : std::true_type
+{
+  static_assert((std::is_trivially_copyable_v<SnapshotMemberType<T, First>> && ... && std::is_trivially_copyable_v<SnapshotMemberType<T, Rest>>), "Snapshot run has to be plain data");
+  static_assert(SnapshotRunPacked<1 + sizeof...(Rest)>({ sizeof(SnapshotMemberType<T, First>), sizeof(SnapshotMemberType<T, Rest>)... },
+    { alignof(SnapshotMemberType<T, First>), alignof(SnapshotMemberType<T, Rest>)... }), "Snapshot run has padding between its members");
+
+  //! Bytes in the run
+  static constexpr size_t Bytes = (sizeof(SnapshotMemberType<T, First>) + ... + sizeof(SnapshotMemberType<T, Rest>));
+
+  //! Offset of the run from the start of the component
+  static size_t Offset(const T& component) { return reinterpret_cast<const char*>(&(component.*First)) - reinterpret_cast<const char*>(&component); }
+  //! Bytes in the run. Checks that no member between the listed ones was left out
+  static size_t Size(const T& component)
+  {
+    assert(reinterpret_cast<const char*>(&(component.*Last)) + sizeof(component.*Last) - reinterpret_cast<const char*>(&(component.*First)) == Bytes
+      && "Snapshot run is missing a member.");
+    return Bytes;
+  }
+
+private:
+  //! Last member of the run
+  static constexpr auto Last = std::get<sizeof...(Rest)>(std::tuple<decltype(First), decltype(Rest)...>(First, Rest...));
+};
@@ -1,19 +1,29 @@
 #pragma once
 #include "Core/ECS/Entity.h"
 #include "Core/ECS/ComponentTraits.h"
+#include "Core/ECS/ComponentArray.h"
+#include "Core/ECS/EntityManager.h"
+#include "Core/ECS/EntitySet.h"
+#include "Core/ECS/SystemRegistry.h"
 #include "Core/Utility/Profiler.h"
 
 #include <cstdint>
-#include <map>
-
-#include <set>
+#include <tuple>
 
 template <typename ... T>
-struct Requires {};
+struct Requires
+{
+  static ComponentBitFlag Signature() { return ComponentBitFlag(); }
+};
 
 template <typename T>
 struct Requires<T>
 {
+  static ComponentBitFlag Signature()
+  {
+    return ComponentTraits<T>::Get().GetSignature();
+  }
+
   static bool MatchesSignature(EntityID entity)
   {
     return (EntityManager::Get().GetSignature(entity) & ComponentTraits<T>::Get().GetSignature()) == ComponentTraits<T>::Get().GetSignature();
@@ -23,6 +33,11 @@ struct Requires<T>
 template <typename T, typename ... Rest>
 struct Requires<T, Rest...>
 {
+  static ComponentBitFlag Signature()
+  {
+    return ComponentTraits<T>::Get().GetSignature() | (ComponentTraits<Rest>::Get().GetSignature() | ...);
+  }
+
   static bool MatchesSignature(EntityID entity)
   {
     auto combinedSignature = ComponentTraits<T>::Get().GetSignature() | (ComponentTraits<Rest>::Get().GetSignature() | ...);
@@ -36,21 +51,46 @@ struct Requires<T, Rest...>
   }
 };
 
+//! Membership set that registers itself with the SystemRegistry when the system's set is first instantiated
+template <typename ... T>
+class SystemEntitySet : public EntitySet
+{
+public:
+  SystemEntitySet() { SystemRegistry::Get().RegisterSystem(this, Requires<T...>::Signature()); }
+};
+
 template <typename ... T>
 class ISystem
 {
 public:
-  //! Check if entity's component signature has required components
-  //! called on AddComponent and RemoveComponent
-  static void Check(Entity* entity)
+  //! Set of registered entities (iterated in ascending ID order). Membership is kept up to date by
+  //! the SystemRegistry whenever an entity's signature changes
+  static SystemEntitySet<T...> Registered;
+
+  //! Runs fn(entity, T&...) for every registered entity in ascending ID order (same order as iterating Registered,
+  //! which keeps the simulation deterministic for rollback). Don't add or remove the required components inside fn
+  template <typename Fn>
+  static void ForEach(Fn&& fn)
   {
-    if(Req::MatchesSignature(entity->GetID()))
-      Registered.insert(entity->GetID());
-    else
-      Registered.erase(entity->GetID());
+    std::tuple<ComponentArray<T>&...> arrays(ComponentArray<T>::Get()...);
+    for (const EntityID entity : Registered)
+      fn(entity, std::get<ComponentArray<T>&>(arrays).GetComponent(entity)...);
   }
-  //! Set of registered entities
-  static std::set<EntityID> Registered;
+
+  //! Scheduler annotations (see SystemScheduler), hidden by systems that declare their component access.
+  //! Required components are treated as written unless listed in ReadsOnly
+  using ReadsOnly = Requires<>;
+  //! Components accessed outside of the required ones
+  using AlsoReads = Requires<>;
+  using AlsoWrites = Requires<>;
+  //! Exclusive systems run alone on the main thread. Only clear it for systems that make no structural changes, call no
+  //! callbacks and touch nothing but the components they declare
+  static constexpr bool Exclusive = true;
+  //! Presentation systems only feed what is shown (UI layout, effects...) and are skipped on resimulated frames.
+  //! Nothing they write can be part of the saved state
+  static constexpr bool Presentation = false;
+  //! Components the system ticks over
+  static ComponentBitFlag RequiredSignature() { return Requires<T...>::Signature(); }
 
 protected:
   //! Required components
@@ -58,11 +98,8 @@ protected:
 
 };
 
-//template <typename ... T>
-//std::map<int, std::tuple<T&...>> ISystem<T...>::Tuples;
-
 template <typename ... T>
-std::set<EntityID> ISystem<T...>::Registered;
+SystemEntitySet<T...> ISystem<T...>::Registered;
 
 
 //_________________________________________________________________________
@@ -82,9 +119,12 @@ public:
 
   class SubSystem : public ISystem<Sub...> {};
 
-  static void Check(Entity* entity)
-  {
-    MainSystem::Check(entity);
-    SubSystem::Check(entity);
-  }
+  //! Scheduler annotations, same as for ISystem
+  using ReadsOnly = Requires<>;
+  using AlsoReads = Requires<>;
+  using AlsoWrites = Requires<>;
+  static constexpr bool Exclusive = true;
+  static constexpr bool Presentation = false;
+  //! Components of both the main and sub systems
+  static ComponentBitFlag RequiredSignature() { return Requires<Main...>::Signature() | Requires<Sub...>::Signature(); }
 };
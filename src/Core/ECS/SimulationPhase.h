@@ -0,0 +1,11 @@
+#pragma once
+
+//______________________________________________________________________________
+//! What the frame being run is for
+enum class SimulationPhase
+{
+  //! The newest frame (confirmed or predicted), the one that gets shown
+  Present,
+  //! A frame run again during a rollback to catch up to the present. Nothing it does is shown
+  Resimulate
+};
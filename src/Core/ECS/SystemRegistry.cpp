@@ -0,0 +1,50 @@
+#include "Core/ECS/SystemRegistry.h"
+
+//______________________________________________________________________________
+void SystemRegistry::RegisterSystem(EntitySet* registered, const ComponentBitFlag& signature)
+{
+  const uint32_t systemIndex = static_cast<uint32_t>(_systems.size());
+  _systems.push_back(SystemEntry{ signature, registered, 0 });
+
+  for (size_t compIndex = 0; compIndex < MAX_COMPONENTS; compIndex++)
+  {
+    if (signature.test(compIndex))
+      _systemsByComponent[compIndex].push_back(systemIndex);
+  }
+}
+
+//______________________________________________________________________________
+void SystemRegistry::CheckEntity(EntityID entity)
+{
+  if (entity >= EntityManager::Get().IDRange())
+    return;
+  if (entity >= _checkedSignatures.size())
+    _checkedSignatures.resize(EntityManager::Get().IDRange());
+
+  const ComponentBitFlag signature = EntityManager::Get().GetSignature(entity);
+  const ComponentBitFlag changed = signature ^ _checkedSignatures[entity];
+  _checkedSignatures[entity] = signature;
+
+  if (changed.none())
+    return;
+
+  _visitStamp++;
+  for (size_t compIndex = 0; compIndex < MAX_COMPONENTS; compIndex++)
+  {
+    if (!changed.test(compIndex))
+      continue;
+
+    for (uint32_t systemIndex : _systemsByComponent[compIndex])
+    {
+      SystemEntry& system = _systems[systemIndex];
+      if (system.lastVisit == _visitStamp)
+        continue;
+      system.lastVisit = _visitStamp;
+
+      if ((signature & system.signature) == system.signature)
+        system.registered->insert(entity);
+      else
+        system.registered->erase(entity);
+    }
+  }
+}
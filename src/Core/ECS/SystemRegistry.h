@@ -0,0 +1,54 @@
+#pragma once
+#include "Core/ECS/EntityManager.h"
+#include "Core/ECS/EntitySet.h"
+
+#include <array>
+#include <vector>
+
+//______________________________________________________________________________
+//! Keeps every system's required signature and membership set, indexed by component bit, so that a
+//! structural change only re-tests the systems that care about the components that changed
+class SystemRegistry
+{
+public:
+  //! Static getter
+  static SystemRegistry& Get()
+  {
+    static SystemRegistry registry;
+    return registry;
+  }
+
+  //! Adds a system's entity set with the signature an entity needs to be registered in it
+  void RegisterSystem(EntitySet* registered, const ComponentBitFlag& signature);
+  //! Re-tests entity against the systems whose signature contains a bit changed since its last check
+  void CheckEntity(EntityID entity);
+  //! Number of systems registered
+  size_t NumSystems() const { return _systems.size(); }
+
+private:
+  SystemRegistry() = default;
+  SystemRegistry(const SystemRegistry&) = delete;
+  SystemRegistry(SystemRegistry&&) = delete;
+  SystemRegistry operator=(const SystemRegistry&) = delete;
+  SystemRegistry operator=(SystemRegistry&&) = delete;
+
+  struct SystemEntry
+  {
+    //! Required components
+    ComponentBitFlag signature;
+    //! Membership set of the system
+    EntitySet* registered;
+    //! Stamp of the last check that visited this system, so a system is only tested once per check
+    uint32_t lastVisit;
+  };
+
+  //! All registered systems
+  std::vector<SystemEntry> _systems;
+  //! Index of the systems requiring each component bit
+  std::array<std::vector<uint32_t>, MAX_COMPONENTS> _systemsByComponent;
+  //! Signature of each entity the last time it was checked against the systems (grows with the entity id range)
+  std::vector<ComponentBitFlag> _checkedSignatures;
+  //! Incremented on every check
+  uint32_t _visitStamp = 0;
+
+};
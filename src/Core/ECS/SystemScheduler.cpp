@@ -0,0 +1,114 @@
+#include "Core/ECS/SystemScheduler.h"
+#include "Core/Utility/ThreadPool.h"
+
+bool SystemScheduler::Parallel = true;
+SimulationPhase SystemScheduler::Phase = SimulationPhase::Present;
+
+//______________________________________________________________________________
+void SystemScheduler::AddExclusive(TickFn tick, bool presentation)
+{
+  AddNode(tick, ComponentBitFlag(), ComponentBitFlag(), true, presentation);
+}
+
+//______________________________________________________________________________
+void SystemScheduler::AddNode(TickFn tick, ComponentBitFlag reads, ComponentBitFlag writes, bool exclusive, bool presentation)
+{
+  const uint32_t index = static_cast<uint32_t>(_nodes.size());
+  _nodes.push_back(Node{ tick, reads, writes, exclusive, presentation, {}, 0 });
+
+  if (exclusive)
+  {
+    // everything before has finished by the time it runs, and everything after starts once it's done
+    _batchStart = index + 1;
+  }
+  else
+  {
+    Node& node = _nodes.back();
+    for (uint32_t i = _batchStart; i < index; i++)
+    {
+      Node& other = _nodes[i];
+      const bool conflicts = (node.writes & (other.reads | other.writes)).any() || (node.reads & other.writes).any();
+      if (conflicts)
+      {
+        other.successors.push_back(index);
+        node.nPredecessors++;
+      }
+    }
+  }
+
+  _pending = std::vector<std::atomic<uint32_t>>(_nodes.size());
+}
+
+//______________________________________________________________________________
+void SystemScheduler::Run(float dt)
+{
+  _dt = dt;
+  if (!Parallel || ThreadPool::Get().NumWorkers() == 0)
+  {
+    for (const Node& node : _nodes)
+      Tick(node);
+    return;
+  }
+
+  uint32_t begin = 0;
+  for (uint32_t i = 0; i < _nodes.size(); i++)
+  {
+    if (_nodes[i].exclusive)
+    {
+      RunBatch(begin, i);
+      Tick(_nodes[i]);
+      begin = i + 1;
+    }
+  }
+  RunBatch(begin, static_cast<uint32_t>(_nodes.size()));
+}
+
+//______________________________________________________________________________
+void SystemScheduler::RunBatch(uint32_t begin, uint32_t end)
+{
+  if (end - begin == 0)
+    return;
+
+  // not worth a round trip through the pool
+  if (end - begin == 1)
+  {
+    Tick(_nodes[begin]);
+    return;
+  }
+
+  for (uint32_t i = begin; i < end; i++)
+    _pending[i] = _nodes[i].nPredecessors;
+  _remaining = end - begin;
+
+  for (uint32_t i = begin; i < end; i++)
+  {
+    if (_nodes[i].nPredecessors == 0)
+      ThreadPool::Get().Submit(ThreadPool::Task{ &SystemScheduler::RunNode, this, i });
+  }
+
+  ThreadPool::Get().HelpUntil([this]() { return _remaining == 0; });
+}
+
+//______________________________________________________________________________
+void SystemScheduler::Tick(const Node& node) const
+{
+  // a skipped node still releases its successors, so the ordering of everything else doesn't change
+  if (node.presentation && !Presenting())
+    return;
+  node.tick(_dt);
+}
+
+//______________________________________________________________________________
+void SystemScheduler::RunNode(void* scheduler, uint32_t index)
+{
+  SystemScheduler& self = *static_cast<SystemScheduler*>(scheduler);
+  const Node& node = self._nodes[index];
+  self.Tick(node);
+
+  for (const uint32_t successor : node.successors)
+  {
+    if (--self._pending[successor] == 0)
+      ThreadPool::Get().Submit(ThreadPool::Task{ &SystemScheduler::RunNode, scheduler, successor });
+  }
+  self._remaining--;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "Core/ECS/ISystem.h"
+#include "Core/ECS/SimulationPhase.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//______________________________________________________________________________
+//! Runs a fixed list of system ticks, spreading them over the ThreadPool where their component access allows it.
+//! Each system's reads and writes come from its ISystem annotations. Two systems conflict if either writes something
+//! the other accesses, and conflicting systems always run in the order they were added, so the results are the same
+//! as ticking everything serially. Exclusive systems (the default) split the list: they run alone on the main thread
+//! after everything added before them has finished. Presentation systems are skipped on resimulated frames
+class SystemScheduler
+{
+public:
+  using TickFn = void(*)(float);
+
+  //! Adds a system using its scheduler annotations
+  template <typename System>
+  void Add(TickFn tick = &System::DoTick);
+  //! Adds a tick that runs alone on the main thread (aggregates, conditional calls...)
+  void AddExclusive(TickFn tick, bool presentation = false);
+
+  //! Runs every tick for this frame
+  void Run(float dt);
+
+  //! Whether schedulers use the thread pool at all. When off, everything ticks serially on the calling thread
+  static bool Parallel;
+  //! Phase of the frame being run, set by whoever runs it
+  static SimulationPhase Phase;
+  //! Whether presentation systems (and anything else that only feeds what is shown) should run this frame
+  static bool Presenting() { return Phase == SimulationPhase::Present; }
+
+private:
+  struct Node
+  {
+    TickFn tick;
+    ComponentBitFlag reads;
+    ComponentBitFlag writes;
+    bool exclusive;
+    //! Skipped on resimulated frames
+    bool presentation;
+    //! Nodes that have to wait for this one
+    std::vector<uint32_t> successors;
+    //! Number of nodes this one waits for
+    uint32_t nPredecessors = 0;
+  };
+
+  //! Adds the node and its ordering edges to conflicting nodes since the last exclusive one
+  void AddNode(TickFn tick, ComponentBitFlag reads, ComponentBitFlag writes, bool exclusive, bool presentation);
+  //! Runs the node's tick unless the phase skips it
+  void Tick(const Node& node) const;
+  //! Runs the non exclusive nodes [begin, end) on the thread pool and waits for them
+  void RunBatch(uint32_t begin, uint32_t end);
+  //! Thread pool entry point
+  static void RunNode(void* scheduler, uint32_t index);
+
+  std::vector<Node> _nodes;
+  //! First node after the last exclusive one
+  uint32_t _batchStart = 0;
+
+  //! Per node count of predecessors that haven't finished in the current batch
+  std::vector<std::atomic<uint32_t>> _pending;
+  //! Nodes of the current batch that haven't finished
+  std::atomic<uint32_t> _remaining = 0;
+  //! Time step of the current run
+  float _dt = 0.0f;
+
+};
+
+//______________________________________________________________________________
+template <typename System>
+inline void SystemScheduler::Add(TickFn tick)
+{
+  const ComponentBitFlag readsOnly = System::ReadsOnly::Signature();
+  const ComponentBitFlag reads = readsOnly | System::AlsoReads::Signature();
+  const ComponentBitFlag writes = (System::RequiredSignature() | System::AlsoWrites::Signature()) & ~readsOnly;
+  AddNode(tick, reads, writes, System::Exclusive, System::Presentation);
+}
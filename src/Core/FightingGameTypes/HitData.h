@@ -19,7 +19,7 @@ struct HitData : ISerializable
     Serializer<int>::Serialize(os, framesInStunBlock);
     Serializer<int>::Serialize(os, framesInStunHit);
     Serializer<int>::Serialize(os, activeFrames);
-    os << knockback;
+    Serializer<Vector2<float>>::Serialize(os, knockback);
     Serializer<int>::Serialize(os, damage);
     Serializer<bool>::Serialize(os, knockdown);
     Serializer<HitType>::Serialize(os, type);
@@ -30,7 +30,7 @@ struct HitData : ISerializable
     Serializer<int>::Deserialize(is, framesInStunBlock);
     Serializer<int>::Deserialize(is, framesInStunHit);
     Serializer<int>::Deserialize(is, activeFrames);
-    is >> knockback;
+    Serializer<Vector2<float>>::Deserialize(is, knockback);
     Serializer<int>::Deserialize(is, damage);
     Serializer<bool>::Deserialize(is, knockdown);
     Serializer<HitType>::Deserialize(is, type);
@@ -103,20 +103,10 @@ std::shared_ptr<Entity> CharacterConstructor::InitUIComponents(std::shared_ptr<E
   {
     if (lastState->hitting && newState->comboCounter > 1)
     {
-      auto& activeTimers = entity->GetComponent<TimerContainer>()->timings;
-      if (!activeTimers.empty())
-      {
-        for (auto timer : activeTimers)
-          timer->Cancel();
-      }
-
       const int comboTextVisibleFrames = 35;
       // replace active timer with new one that will remove render properties to hide the text
-      std::shared_ptr<ActionTimer> endComboText = std::shared_ptr<ActionTimer>(new SimpleActionTimer([entity]()
-        {
-          entity->RemoveComponent<RenderProperties>();
-        }, comboTextVisibleFrames));
-      entity->GetComponent<TimerContainer>()->timings.push_back(endComboText);
+      entity->GetComponent<TimerContainer>()->CancelAll();
+      entity->GetComponent<TimerContainer>()->Start(TimerCallbacks::HideOwner, comboTextVisibleFrames);
 
       // ensure the combo text is visible
       entity->AddComponent<RenderProperties>();
@@ -0,0 +1,93 @@
+#include "Core/Rollback/ConditionedTransport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//______________________________________________________________________________
+ConditionedTransport::ConditionedTransport(std::unique_ptr<IRollbackTransport> transport, const NetworkConditions& conditions, Clock clock) :
+  _transport(std::move(transport)), _conditions(conditions), _clock(std::move(clock)), _rng(conditions.seed) {}
+
+//______________________________________________________________________________
+int64_t ConditionedTransport::SystemMilliseconds()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//______________________________________________________________________________
+double SeededRandom::Normal()
+{
+  // 1 - u is in (0, 1], so the log is finite. The second value of the pair is dropped so each draw takes the same outputs
+  const double u = 1.0 - Uniform();
+  const double v = Uniform();
+  return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+}
+
+//______________________________________________________________________________
+bool ConditionedTransport::Send(const void* data, size_t size)
+{
+  _stats.sent++;
+  const int64_t now = _clock();
+
+  // every draw is made for every packet so a setting of 0 doesn't shift the draws of the others
+  const bool lost = _rng.Uniform() < _conditions.loss;
+  const bool reordered = _rng.Uniform() < _conditions.reorder;
+  const int64_t delay = DrawDelay();
+
+  if (lost)
+  {
+    _stats.lost++;
+    Deliver();
+    return true;
+  }
+
+  int64_t deliverAt = now + delay;
+  if (reordered)
+  {
+    _stats.reordered++;
+    deliverAt += _conditions.reorderMs;
+  }
+  else
+  {
+    deliverAt = std::max(deliverAt, _lastInOrder);
+    _lastInOrder = deliverAt;
+  }
+
+  const char* bytes = static_cast<const char*>(data);
+  auto it = std::upper_bound(_inFlight.begin(), _inFlight.end(), deliverAt, [](int64_t time, const Packet& packet) { return time < packet.deliverAt; });
+  _inFlight.insert(it, Packet{ deliverAt, std::vector<char>(bytes, bytes + size) });
+
+  Deliver();
+  return true;
+}
+
+//______________________________________________________________________________
+size_t ConditionedTransport::Receive(void* data, size_t capacity)
+{
+  // the other end may not be sending anything, packets still have to go out when they are due
+  Deliver();
+  return _transport->Receive(data, capacity);
+}
+
+//______________________________________________________________________________
+int64_t ConditionedTransport::DrawDelay()
+{
+  double jitter = 0.0;
+  if (_conditions.jitterShape == NetworkConditions::JitterShape::Uniform)
+    jitter = (_rng.Uniform() * 2.0 - 1.0) * _conditions.jitterMs;
+  else
+    jitter = _rng.Normal() * _conditions.jitterMs;
+
+  return std::max<int64_t>(0, _conditions.delayMs + std::llround(jitter));
+}
+
+//______________________________________________________________________________
+void ConditionedTransport::Deliver()
+{
+  const int64_t now = _clock();
+  while (!_inFlight.empty() && _inFlight.front().deliverAt <= now)
+  {
+    _transport->Send(_inFlight.front().data.data(), _inFlight.front().data.size());
+    _inFlight.pop_front();
+  }
+}
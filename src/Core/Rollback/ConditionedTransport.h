@@ -0,0 +1,110 @@
+#pragma once
+#include "Core/Rollback/RollbackTransport.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <random>
+
+//______________________________________________________________________________
+//! Seeded draws made straight from the output of a mt19937. The engine is specified exactly but the standard
+//! distributions aren't, so they give other numbers with another standard library. These mappings are fixed, the same
+//! seed draws the same values on every platform
+class SeededRandom
+{
+public:
+  explicit SeededRandom(uint32_t seed) : _engine(seed) {}
+
+  //! In [0, 1), from 53 bits of two outputs
+  double Uniform()
+  {
+    const uint64_t high = _engine() >> 5;
+    const uint64_t low = _engine() >> 6;
+    return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+  }
+  //! Standard normal, by Box-Muller
+  double Normal();
+  //! In [0, count), from the high bits of one output
+  uint32_t Below(uint32_t count) { return static_cast<uint32_t>((static_cast<uint64_t>(_engine()) * count) >> 32); }
+
+private:
+  std::mt19937 _engine;
+
+};
+
+//______________________________________________________________________________
+//! Network conditions to simulate on the packets one end of a link sends
+struct NetworkConditions
+{
+  enum class JitterShape { Uniform, Normal };
+
+  //! One way delay added to every packet, in milliseconds
+  int delayMs = 0;
+  //! Spread of the delay around delayMs: the half width of a uniform spread, or the standard deviation of a normal one
+  int jitterMs = 0;
+  JitterShape jitterShape = JitterShape::Uniform;
+  //! Chance (0 to 1) that a packet is lost
+  float loss = 0.0f;
+  //! Chance (0 to 1) that a packet is held back for reorderMs, letting the ones sent after it arrive first
+  float reorder = 0.0f;
+  int reorderMs = 20;
+  //! Seed of the draws, the same seed and clock give the same packet timings
+  uint32_t seed = 0;
+};
+
+//______________________________________________________________________________
+//! Shapes the packets sent through another transport: each one is lost, or held until its delivery time on the clock and
+//! then sent. Packets arrive in the order they were sent unless they are picked to be reordered, jitter alone doesn't
+//! reorder them. With a clock that counts frames the whole link is reproducible, with the system clock it can shape a
+//! real socket (over 127.0.0.1 for instance)
+class ConditionedTransport : public IRollbackTransport
+{
+public:
+  //! Current time in milliseconds
+  using Clock = std::function<int64_t()>;
+
+  struct Stats
+  {
+    int sent = 0;
+    int lost = 0;
+    int reordered = 0;
+  };
+
+  ConditionedTransport(std::unique_ptr<IRollbackTransport> transport, const NetworkConditions& conditions, Clock clock);
+  //! Time from the system's steady clock
+  static int64_t SystemMilliseconds();
+
+  //! Always succeeds, a lost packet is lost on the way
+  bool Send(const void* data, size_t size) override;
+  size_t Receive(void* data, size_t capacity) override;
+
+  const NetworkConditions& GetConditions() const { return _conditions; }
+  const Stats& GetStats() const { return _stats; }
+  //! Packets sent that haven't been delivered yet
+  size_t InFlight() const { return _inFlight.size(); }
+
+private:
+  struct Packet
+  {
+    int64_t deliverAt;
+    std::vector<char> data;
+  };
+
+  //! Delay of the next packet: delay plus jitter, never negative
+  int64_t DrawDelay();
+  //! Sends the packets that are due
+  void Deliver();
+
+  std::unique_ptr<IRollbackTransport> _transport;
+  NetworkConditions _conditions;
+  Clock _clock;
+  SeededRandom _rng;
+
+  //! Packets waiting to be sent, by delivery time (packets due at the same time stay in the order they were sent)
+  std::deque<Packet> _inFlight;
+  //! Delivery time of the last packet sent in order, later ones can't arrive before it
+  int64_t _lastInOrder = 0;
+  Stats _stats;
+
+};
@@ -0,0 +1,123 @@
+#include "Core/Rollback/Replay.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+
+//______________________________________________________________________________
+void Replay::Reset(const Header& header)
+{
+  _header = header;
+  _header.keyframeInterval = std::max(_header.keyframeInterval, 1);
+  _inputs.clear();
+  _keyframes.clear();
+}
+
+//______________________________________________________________________________
+void Replay::AddKeyframe(int frame, SBuffer state)
+{
+  assert((_keyframes.empty() || _keyframes.back().frame < frame) && "Keyframes have to be added in frame order");
+  _keyframes.push_back(Keyframe{ frame, std::move(state) });
+}
+
+//______________________________________________________________________________
+void Replay::AddFrame(const InputState* inputs)
+{
+  _inputs.insert(_inputs.end(), inputs, inputs + NumPlayers);
+}
+
+//______________________________________________________________________________
+const Replay::Keyframe* Replay::KeyframeBefore(int frame) const
+{
+  auto after = std::upper_bound(_keyframes.begin(), _keyframes.end(), frame, [](int f, const Keyframe& keyframe) { return f < keyframe.frame; });
+  return after == _keyframes.begin() ? nullptr : &*(after - 1);
+}
+
+//______________________________________________________________________________
+bool Replay::Save(const std::string& path) const
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+
+  Serializer<uint32_t>::Serialize(file, Magic);
+  Serializer<uint32_t>::Serialize(file, Version);
+  Serializer<std::string>::Serialize(file, _header.p1Character);
+  Serializer<std::string>::Serialize(file, _header.p2Character);
+  Serializer<int>::Serialize(file, _header.battleType);
+  Serializer<int>::Serialize(file, _header.keyframeInterval);
+
+  Serializer<int>::Serialize(file, Frames());
+  file.write(reinterpret_cast<const char*>(_inputs.data()), _inputs.size() * sizeof(InputState));
+
+  Serializer<int>::Serialize(file, Keyframes());
+  for (const Keyframe& keyframe : _keyframes)
+  {
+    Serializer<int>::Serialize(file, keyframe.frame);
+    Serializer<uint32_t>::Serialize(file, static_cast<uint32_t>(keyframe.state.size()));
+    file.write(keyframe.state.data(), keyframe.state.size());
+  }
+  return static_cast<bool>(file);
+}
+
+//______________________________________________________________________________
+bool Replay::Load(const std::string& path)
+{
+  Reset(Header());
+
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+
+  // the counts and sizes come from the file, so they're checked against what's left of it before anything is sized
+  // from them. A corrupt or truncated file is rejected instead of allocating whatever it claims
+  const std::streamoff fileSize = file.tellg();
+  file.seekg(0);
+  auto bytesLeft = [&file, fileSize]() { return static_cast<uint64_t>(std::max<std::streamoff>(fileSize - file.tellg(), 0)); };
+
+  uint32_t magic = 0, version = 0;
+  Serializer<uint32_t>::Deserialize(file, magic);
+  Serializer<uint32_t>::Deserialize(file, version);
+  if (!file || magic != Magic || version != Version)
+    return false;
+
+  Header header;
+  Serializer<std::string>::Deserialize(file, header.p1Character);
+  Serializer<std::string>::Deserialize(file, header.p2Character);
+  Serializer<int>::Deserialize(file, header.battleType);
+  Serializer<int>::Deserialize(file, header.keyframeInterval);
+
+  int frames = 0;
+  Serializer<int>::Deserialize(file, frames);
+  if (!file || frames < 0 || static_cast<uint64_t>(frames) * NumPlayers * sizeof(InputState) > bytesLeft())
+    return false;
+  std::vector<InputState> inputs(static_cast<size_t>(frames) * NumPlayers);
+  file.read(reinterpret_cast<char*>(inputs.data()), inputs.size() * sizeof(InputState));
+
+  int nKeyframes = 0;
+  Serializer<int>::Deserialize(file, nKeyframes);
+  // every keyframe has at least its frame and size
+  if (!file || nKeyframes < 0 || static_cast<uint64_t>(nKeyframes) * (sizeof(int) + sizeof(uint32_t)) > bytesLeft())
+    return false;
+
+  std::vector<Keyframe> keyframes(nKeyframes);
+  for (Keyframe& keyframe : keyframes)
+  {
+    uint32_t size = 0;
+    Serializer<int>::Deserialize(file, keyframe.frame);
+    Serializer<uint32_t>::Deserialize(file, size);
+    if (!file || size > bytesLeft())
+      return false;
+    keyframe.state.resize(size);
+    file.read(keyframe.state.data(), size);
+  }
+  auto earlier = [](const Keyframe& a, const Keyframe& b) { return a.frame < b.frame; };
+  if (!file || !std::is_sorted(keyframes.begin(), keyframes.end(), earlier))
+    return false;
+
+  Reset(header);
+  _inputs = std::move(inputs);
+  _keyframes = std::move(keyframes);
+  return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "Core/InputState.h"
+#include "Core/Interfaces/Serializable.h"
+
+#include <string>
+#include <vector>
+
+//______________________________________________________________________________
+//! A recorded match: the inputs of both players on every frame plus a full game state snapshot every few hundred
+//! frames. Since the simulation is deterministic, any frame can be reached by loading the last keyframe before it and
+//! running the recorded inputs from there, instead of simulating from the first frame
+class Replay
+{
+public:
+  static constexpr int NumPlayers = 2;
+  static constexpr int DefaultKeyframeInterval = 300;
+
+  struct Keyframe
+  {
+    //! Frame the state is the start of
+    int frame;
+    //! Full game state snapshot
+    SBuffer state;
+  };
+
+  //! What the match has to be set up with before any keyframe can be loaded
+  struct Header
+  {
+    std::string p1Character;
+    std::string p2Character;
+    int battleType = 0;
+    //! Frames between two keyframes
+    int keyframeInterval = DefaultKeyframeInterval;
+  };
+
+  //! Drops every frame and keyframe and starts over with the header
+  void Reset(const Header& header);
+  const Header& GetHeader() const { return _header; }
+
+  //! Whether the state at the start of the frame has to be added as a keyframe before the frame's inputs
+  bool WantsKeyframe(int frame) const { return frame % _header.keyframeInterval == 0; }
+  //! Adds the state at the start of the frame. Keyframes have to be added in frame order
+  void AddKeyframe(int frame, SBuffer state);
+  //! Adds the inputs (NumPlayers long) of the next frame
+  void AddFrame(const InputState* inputs);
+
+  //! Number of recorded frames
+  int Frames() const { return static_cast<int>(_inputs.size() / NumPlayers); }
+  //! Inputs of the frame, NumPlayers long
+  const InputState* FrameInputs(int frame) const { return &_inputs[static_cast<size_t>(frame) * NumPlayers]; }
+  //! Last keyframe at or before the frame, nullptr if there is none
+  const Keyframe* KeyframeBefore(int frame) const;
+  int Keyframes() const { return static_cast<int>(_keyframes.size()); }
+
+  //! Writes the replay to a file. Returns false if it couldn't be written
+  bool Save(const std::string& path) const;
+  //! Reads a replay written by Save, replacing this one. Returns false (leaving this one empty) if the file can't be
+  //! read or isn't a replay of this version
+  bool Load(const std::string& path);
+
+private:
+  //! Written at the start of every file
+  static constexpr uint32_t Magic = 0x50524746; // "FGRP"
+  static constexpr uint32_t Version = 1;
+
+  Header _header;
+  //! NumPlayers inputs per frame
+  std::vector<InputState> _inputs;
+  //! In frame order
+  std::vector<Keyframe> _keyframes;
+
+};
@@ -0,0 +1,68 @@
+#include "Core/Rollback/RewindBuffer.h"
+
+#include <cassert>
+#include <cstring>
+
+//______________________________________________________________________________
+void RewindBuffer::Allocate(size_t maxFrames, size_t capacity)
+{
+  _data = std::make_unique<char[]>(capacity);
+  _capacity = capacity;
+  _frames.assign(maxFrames > 0 ? maxFrames : 1, Frame{ 0, 0, 0 });
+  Clear();
+}
+
+//______________________________________________________________________________
+void RewindBuffer::Release()
+{
+  _data.reset();
+  _capacity = 0;
+  _frames.clear();
+  Clear();
+}
+
+//______________________________________________________________________________
+bool RewindBuffer::Push(int frame, const char* data, size_t size)
+{
+  if (!Allocated() || size > _capacity)
+    return false;
+
+  size_t offset = _cursor;
+  if (offset + size > _capacity)
+  {
+    // the frames between the cursor and the end are the oldest ones, and the gap they leave isn't reused
+    while (_count > 0 && Entry(0).offset >= _cursor)
+      PopOldest();
+    offset = 0;
+  }
+
+  // frames are laid out in the order they were pushed, so the ones in the way are always the oldest
+  while (_count > 0 && Entry(0).offset < offset + size && Entry(0).offset + Entry(0).size > offset)
+    PopOldest();
+  if (_count == _frames.size())
+    PopOldest();
+
+  std::memcpy(_data.get() + offset, data, size);
+  _frames[(_head + _count) % _frames.size()] = Frame{ frame, offset, static_cast<uint32_t>(size) };
+  _count++;
+  _cursor = offset + size;
+  return true;
+}
+
+//______________________________________________________________________________
+void RewindBuffer::TruncateAfter(int i)
+{
+  assert(i >= 0 && i < Count());
+  _count = static_cast<size_t>(i) + 1;
+  const Frame& newest = Entry(i);
+  _cursor = newest.offset + newest.size;
+}
+
+//______________________________________________________________________________
+size_t RewindBuffer::BytesUsed() const
+{
+  size_t used = 0;
+  for (int i = 0; i < Count(); i++)
+    used += SizeAt(i);
+  return used;
+}
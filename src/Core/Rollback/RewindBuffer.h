@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//______________________________________________________________________________
+//! The last frames' snapshots packed back to back in one buffer allocated up front. Pushing a frame copies it after the
+//! newest one, wrapping to the start of the buffer when it doesn't fit before the end, and drops the oldest frames it
+//! overwrites. Memory never grows past the buffer, so the number of frames kept depends on how big they are, up to
+//! the most frames asked for
+class RewindBuffer
+{
+public:
+  //! Allocates the buffer and room to track maxFrames frames. Any kept frames are dropped
+  void Allocate(size_t maxFrames, size_t capacity);
+  //! Frees the buffer
+  void Release();
+  //! Drops every frame, keeping the memory
+  void Clear() { _head = 0; _count = 0; _cursor = 0; }
+  bool Allocated() const { return _data != nullptr; }
+
+  //! Copies the snapshot in as the newest frame. Returns false (keeping nothing) if it is bigger than the whole buffer
+  bool Push(int frame, const char* data, size_t size);
+  //! Drops every frame newer than the i-th one, so pushing carries on from it
+  void TruncateAfter(int i);
+
+  //! Number of frames kept
+  int Count() const { return static_cast<int>(_count); }
+  //! i-th kept frame, 0 being the oldest
+  int FrameAt(int i) const { return Entry(i).frame; }
+  const char* DataAt(int i) const { return _data.get() + Entry(i).offset; }
+  size_t SizeAt(int i) const { return Entry(i).size; }
+
+  size_t Capacity() const { return _capacity; }
+  //! Bytes taken by the kept frames
+  size_t BytesUsed() const;
+
+private:
+  struct Frame
+  {
+    int frame;
+    size_t offset;
+    uint32_t size;
+  };
+
+  const Frame& Entry(int i) const { return _frames[(_head + static_cast<size_t>(i)) % _frames.size()]; }
+  //! Drops the oldest frame
+  void PopOldest() { _head = (_head + 1) % _frames.size(); _count--; }
+
+  std::unique_ptr<char[]> _data;
+  size_t _capacity = 0;
+  //! Ring of the kept frames, oldest at _head
+  std::vector<Frame> _frames;
+  size_t _head = 0;
+  size_t _count = 0;
+  //! Where the next frame goes if it fits before the end of the buffer
+  size_t _cursor = 0;
+
+};
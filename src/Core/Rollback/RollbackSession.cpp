@@ -0,0 +1,248 @@
+#include "Core/Rollback/RollbackSession.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+
+//______________________________________________________________________________
+RollbackSession::RollbackSession(IRollbackGame& game, std::unique_ptr<IRollbackTransport> transport, int localPlayer, int frameDelay, int maxPrediction) :
+  _game(game), _transport(std::move(transport)), _localPlayer(localPlayer), _remotePlayer(1 - localPlayer),
+  _frameDelay(std::max(frameDelay, 0)), _maxPrediction(std::max(maxPrediction, 1))
+{
+  assert(localPlayer == 0 || localPlayer == 1);
+  assert(_frameDelay + _maxPrediction < InputHistory);
+
+  // saved states live for max prediction frames, plus the confirmed frame and the one being saved
+  _snapshots.Allocate(static_cast<size_t>(_maxPrediction) + 2, SnapshotSlotCapacity);
+
+  // frames before the delay kicks in have no local input
+  for (int frame = 0; frame < _frameDelay; frame++)
+  {
+    InputEntry(_localPlayer, frame) = FrameInput{ frame, InputState::NONE, true };
+    _lastLocalFrame = frame;
+  }
+}
+
+//______________________________________________________________________________
+bool RollbackSession::SyncInputs(InputState* inputs)
+{
+  Idle();
+
+  // add the local input once per frame, SyncInputs is called again for a frame that didn't advance
+  const int localFrame = _currentFrame + _frameDelay;
+  if (_lastLocalFrame < localFrame)
+  {
+    InputEntry(_localPlayer, localFrame) = FrameInput{ localFrame, inputs[_localPlayer], true };
+    _lastLocalFrame = localFrame;
+  }
+  SendInputs();
+
+  if (!_synchronized || _currentFrame - _remoteConfirmedFrame > _maxPrediction)
+  {
+    _stats.stalledFrames++;
+    return false;
+  }
+
+  // state at the very start of the session
+  if (_currentFrame == 0 && !_snapshots.Find(0))
+    SaveCurrentFrame();
+
+  GatherInputs(inputs);
+  return true;
+}
+
+//______________________________________________________________________________
+void RollbackSession::AdvanceFrame()
+{
+  _currentFrame++;
+  SaveCurrentFrame();
+
+  if (_log && !_resimulating && _currentFrame % FramesPerLogLine == 0)
+    WriteLogLine();
+}
+
+//______________________________________________________________________________
+void RollbackSession::SetLog(std::ostream* log)
+{
+  _log = log;
+  _logStart = _stats;
+  _logMaxRollbackFrames = 0;
+  if (_log)
+    *_log << "second,frame_delay,rollbacks,frames_resimulated,max_depth,average_depth,rollback_ms,stalled_frames\n";
+}
+
+//______________________________________________________________________________
+void RollbackSession::WriteLogLine()
+{
+  const int rollbacks = _stats.rollbacks - _logStart.rollbacks;
+  const int frames = _stats.framesResimulated - _logStart.framesResimulated;
+  *_log << _currentFrame / FramesPerLogLine << ',' << _frameDelay << ',' << rollbacks << ',' << frames << ',' << _logMaxRollbackFrames << ','
+    << (rollbacks > 0 ? static_cast<double>(frames) / rollbacks : 0.0) << ','
+    << (_stats.totalRollbackMicroseconds - _logStart.totalRollbackMicroseconds) / 1000.0 << ','
+    << _stats.stalledFrames - _logStart.stalledFrames << '\n';
+
+  _logStart = _stats;
+  _logMaxRollbackFrames = 0;
+}
+
+//______________________________________________________________________________
+void RollbackSession::Idle()
+{
+  if (ReceiveInputs())
+    SendInputs();
+
+  if (_firstIncorrectFrame != NoFrame && !_resimulating)
+    Rollback();
+}
+
+//______________________________________________________________________________
+bool RollbackSession::GetConfirmedInputs(int frame, InputState* inputs) const
+{
+  if (frame < 0 || frame > _remoteConfirmedFrame || frame > _lastLocalFrame)
+    return false;
+
+  for (int player = 0; player < NumPlayers; player++)
+  {
+    const FrameInput& entry = InputEntry(player, frame);
+    if (entry.frame != frame || !entry.confirmed)
+      return false;
+    inputs[player] = entry.input;
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+bool RollbackSession::GetSimulatedInputs(int frame, InputState* inputs) const
+{
+  if (frame < 0 || frame >= _currentFrame)
+    return false;
+
+  for (int player = 0; player < NumPlayers; player++)
+  {
+    const FrameInput& entry = InputEntry(player, frame);
+    if (entry.frame != frame)
+      return false;
+    inputs[player] = entry.input;
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+void RollbackSession::GatherInputs(InputState* inputs)
+{
+  // local inputs are always known this far
+  inputs[_localPlayer] = InputEntry(_localPlayer, _currentFrame).input;
+
+  FrameInput& remote = InputEntry(_remotePlayer, _currentFrame);
+  if (remote.frame != _currentFrame || !remote.confirmed)
+  {
+    // predict the remote keeps doing what it last did, and remember the guess to check it later
+    remote = FrameInput{ _currentFrame, _lastRemoteInput, false };
+  }
+  inputs[_remotePlayer] = remote.input;
+}
+
+//______________________________________________________________________________
+void RollbackSession::SendInputs()
+{
+  InputPacket packet;
+  packet.startFrame = std::max(_remoteAckFrame + 1, 0);
+  packet.ackFrame = _remoteConfirmedFrame;
+  packet.count = static_cast<uint8_t>(std::clamp(_lastLocalFrame - packet.startFrame + 1, 0, MaxInputsPerPacket));
+
+  for (int i = 0; i < packet.count; i++)
+    packet.inputs[i] = InputEntry(_localPlayer, packet.startFrame + i).input;
+
+  // only send the inputs that are used
+  const size_t size = offsetof(InputPacket, inputs) + packet.count * sizeof(InputState);
+  _transport->Send(&packet, size);
+}
+
+//______________________________________________________________________________
+bool RollbackSession::ReceiveInputs()
+{
+  bool received = false;
+  InputPacket packet;
+  size_t size = 0;
+  while ((size = _transport->Receive(&packet, sizeof(InputPacket))) > 0)
+  {
+    // drop anything malformed
+    if (size < offsetof(InputPacket, inputs) || packet.count > MaxInputsPerPacket || size < offsetof(InputPacket, inputs) + packet.count * sizeof(InputState))
+      continue;
+
+    received = true;
+    _synchronized = true;
+    _remoteAckFrame = std::max(_remoteAckFrame, static_cast<int>(packet.ackFrame));
+
+    for (int i = 0; i < packet.count; i++)
+    {
+      const int frame = packet.startFrame + i;
+      // inputs are accepted in order, older packets are duplicates and a gap is filled by a later resend
+      if (frame != _remoteConfirmedFrame + 1)
+        continue;
+
+      FrameInput& entry = InputEntry(_remotePlayer, frame);
+      const bool simulated = entry.frame == frame && frame < _currentFrame;
+      if (simulated && entry.input != packet.inputs[i])
+      {
+        if (_firstIncorrectFrame == NoFrame || frame < _firstIncorrectFrame)
+          _firstIncorrectFrame = frame;
+      }
+
+      entry = FrameInput{ frame, packet.inputs[i], true };
+      _remoteConfirmedFrame = frame;
+      _lastRemoteInput = packet.inputs[i];
+    }
+  }
+  return received;
+}
+
+//______________________________________________________________________________
+void RollbackSession::Rollback()
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  const int targetFrame = _currentFrame;
+  const int loadFrame = _firstIncorrectFrame;
+  _firstIncorrectFrame = NoFrame;
+
+  const SnapshotRing::Slot* slot = _snapshots.Find(loadFrame);
+  assert(slot && "Rolled back further than the saved states go");
+  if (!slot)
+    return;
+
+  _game.LoadGameState(slot->writer.Data(), slot->writer.Size());
+  _currentFrame = loadFrame;
+
+  // the game calls AdvanceFrame at the end of each of these, which moves the current frame along and saves it
+  const auto resimulateStart = std::chrono::steady_clock::now();
+  _resimulating = true;
+  while (_currentFrame < targetFrame)
+  {
+    InputState inputs[NumPlayers];
+    GatherInputs(inputs);
+    _game.AdvanceFrame(inputs, SimulationPhase::Resimulate);
+  }
+  _resimulating = false;
+
+  const int frames = targetFrame - loadFrame;
+  const auto end = std::chrono::steady_clock::now();
+  const long long micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  const long long resimulateMicros = std::chrono::duration_cast<std::chrono::microseconds>(end - resimulateStart).count();
+  _stats.rollbacks++;
+  _stats.framesResimulated += frames;
+  _stats.lastRollbackFrames = frames;
+  _stats.maxRollbackFrames = std::max(_stats.maxRollbackFrames, frames);
+  _logMaxRollbackFrames = std::max(_logMaxRollbackFrames, frames);
+  _stats.lastRollbackMicroseconds = micros;
+  _stats.totalRollbackMicroseconds += micros;
+  _stats.lastResimulateMicroseconds = resimulateMicros;
+  _stats.totalResimulateMicroseconds += resimulateMicros;
+}
+
+//______________________________________________________________________________
+void RollbackSession::SaveCurrentFrame()
+{
+  _snapshots.Save(_currentFrame, [this](SnapshotWriter& writer, SnapshotIndex& index) { _game.SaveGameState(_currentFrame, writer, index); });
+}
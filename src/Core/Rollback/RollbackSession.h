@@ -0,0 +1,169 @@
+#pragma once
+#include "Core/InputState.h"
+#include "Core/ECS/SimulationPhase.h"
+#include "Core/Rollback/RollbackTransport.h"
+#include "Core/Rollback/SnapshotRing.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+//______________________________________________________________________________
+//! Game side of a rollback session, the same hooks GGPO calls back into
+class IRollbackGame
+{
+public:
+  virtual ~IRollbackGame() {}
+  //! Writes the game state at the start of the frame into the writer, marking where each part of it starts in the
+  //! index. The snapshot may depend on earlier saves (delta snapshots), but LoadGameState has to be able to load any
+  //! frame the session still keeps
+  virtual void SaveGameState(int frame, SnapshotWriter& writer, SnapshotIndex& index) = 0;
+  //! Makes the current game state match the saved one. Returns false if the data isn't a state it can load
+  virtual bool LoadGameState(const char* data, size_t size) = 0;
+  //! Runs exactly one frame with the inputs during a rollback. Like a normal frame it has to end with
+  //! RollbackSession::AdvanceFrame. A resimulated frame isn't shown, so it can skip whatever only affects what is shown
+  virtual void AdvanceFrame(const InputState* inputs, SimulationPhase phase) = 0;
+};
+
+//______________________________________________________________________________
+//! Platform independent two player rollback session. Mirrors the GGPO flow: each frame the game calls SyncInputs
+//! with its local input, runs the frame if it returned true and then calls AdvanceFrame. When a remote input arrives
+//! that differs from the one predicted, the session loads the state of that frame and resimulates up to the present
+//! through IRollbackGame::AdvanceFrame
+class RollbackSession
+{
+public:
+  static constexpr int NumPlayers = 2;
+
+  struct Stats
+  {
+    //! Number of rollbacks since the session started
+    int rollbacks = 0;
+    //! Total frames resimulated
+    int framesResimulated = 0;
+    //! Frames resimulated by the last rollback
+    int lastRollbackFrames = 0;
+    //! Deepest rollback
+    int maxRollbackFrames = 0;
+    //! Time spent in the last rollback (load + resimulation) in microseconds
+    long long lastRollbackMicroseconds = 0;
+    //! Time spent in all rollbacks in microseconds
+    long long totalRollbackMicroseconds = 0;
+    //! Time spent running the resimulated frames of the last rollback (without the load) in microseconds
+    long long lastResimulateMicroseconds = 0;
+    //! Time spent running all resimulated frames in microseconds
+    long long totalResimulateMicroseconds = 0;
+    //! Frames SyncInputs held back because the remote was too far behind
+    int stalledFrames = 0;
+  };
+
+  RollbackSession(IRollbackGame& game, std::unique_ptr<IRollbackTransport> transport, int localPlayer, int frameDelay, int maxPrediction);
+
+  //! Adds the local input (inputs[local player]) for the frame the delay puts it in, then fills inputs with the
+  //! inputs to run the current frame with. Returns false if the frame must not run yet (not connected or too far
+  //! ahead of the remote)
+  bool SyncInputs(InputState* inputs);
+  //! Called at the end of every frame the game ran, including resimulated ones. Saves the state of the next frame
+  void AdvanceFrame();
+  //! Receives remote inputs and rolls back if a prediction was wrong. Call while waiting for the next frame
+  void Idle();
+
+  //! Frame that runs next
+  int GetCurrentFrame() const { return _currentFrame; }
+  //! Last frame that all inputs are known for
+  int GetConfirmedFrame() const { return _remoteConfirmedFrame; }
+  int GetLocalPlayer() const { return _localPlayer; }
+  //! Whether a packet has been received from the remote yet
+  bool IsSynchronized() const { return _synchronized; }
+  //! Inputs of both players for the frame, if both are confirmed and the frame is still kept
+  bool GetConfirmedInputs(int frame, InputState* inputs) const;
+  //! Inputs of both players the frame was last simulated with, confirmed or predicted, if the frame is still kept
+  bool GetSimulatedInputs(int frame, InputState* inputs) const;
+  //! Whether frames are being resimulated right now
+  bool IsResimulating() const { return _resimulating; }
+  const Stats& GetStats() const { return _stats; }
+  //! Saved states of the last frames
+  const SnapshotRing& GetSnapshots() const { return _snapshots; }
+  //! Writes a CSV line for every second of frames played (second, frame delay, rollbacks, frames resimulated, deepest and
+  //! average rollback, time spent rolling back, stalled frames), starting with a header. nullptr stops logging
+  void SetLog(std::ostream* log);
+
+private:
+  //! Frames of input kept. Has to cover max prediction plus the frame delay
+  static constexpr int InputHistory = 128;
+  //! Most inputs sent in one packet (unacknowledged inputs are resent until the remote confirms them)
+  static constexpr int MaxInputsPerPacket = 32;
+  //! Initial size of each saved state, slots grow if a state doesn't fit
+  static constexpr size_t SnapshotSlotCapacity = 64 * 1024;
+  static constexpr int NoFrame = -1;
+  //! Frames per line of the log
+  static constexpr int FramesPerLogLine = 60;
+
+  struct FrameInput
+  {
+    //! Frame this entry is for (entries are reused every InputHistory frames)
+    int frame = NoFrame;
+    //! Confirmed input, or the prediction the frame was last simulated with
+    InputState input = InputState::NONE;
+    bool confirmed = false;
+  };
+
+  struct InputPacket
+  {
+    //! Frame of the first input
+    int32_t startFrame;
+    //! Last frame of the receiver's inputs that the sender has (acknowledges them)
+    int32_t ackFrame;
+    //! Number of inputs
+    uint8_t count;
+    InputState inputs[MaxInputsPerPacket];
+  };
+
+  FrameInput& InputEntry(int player, int frame) { return _inputs[player][frame % InputHistory]; }
+  const FrameInput& InputEntry(int player, int frame) const { return _inputs[player][frame % InputHistory]; }
+  //! Inputs for the current frame, predicting the remote input if it isn't confirmed yet
+  void GatherInputs(InputState* inputs);
+  //! Sends the local inputs the remote hasn't acknowledged yet
+  void SendInputs();
+  //! Reads all pending packets. Returns true if any arrived
+  bool ReceiveInputs();
+  //! Restores the first mispredicted frame and resimulates up to the current one
+  void Rollback();
+  //! Saves the current state as the state of the current frame
+  void SaveCurrentFrame();
+  //! Writes the log line of the second that just ended
+  void WriteLogLine();
+
+  IRollbackGame& _game;
+  std::unique_ptr<IRollbackTransport> _transport;
+  SnapshotRing _snapshots;
+
+  int _localPlayer;
+  int _remotePlayer;
+  int _frameDelay;
+  int _maxPrediction;
+
+  FrameInput _inputs[NumPlayers][InputHistory];
+
+  int _currentFrame = 0;
+  //! Last frame the local input has been added for
+  int _lastLocalFrame = NoFrame;
+  //! Last frame the remote input is known for (all frames before it are known too)
+  int _remoteConfirmedFrame = NoFrame;
+  //! Last local frame the remote has acknowledged
+  int _remoteAckFrame = NoFrame;
+  //! Last confirmed remote input, used as the prediction
+  InputState _lastRemoteInput = InputState::NONE;
+  //! Earliest frame simulated with a wrong prediction
+  int _firstIncorrectFrame = NoFrame;
+
+  bool _synchronized = false;
+  bool _resimulating = false;
+  Stats _stats;
+
+  std::ostream* _log = nullptr;
+  //! Stats when the current log line started, and its deepest rollback
+  Stats _logStart;
+  int _logMaxRollbackFrames = 0;
+
+};
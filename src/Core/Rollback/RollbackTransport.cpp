@@ -0,0 +1,164 @@
+#include "Core/Rollback/RollbackTransport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(sockaddr_in) <= 16, "Remote address storage is too small");
+
+//______________________________________________________________________________
+std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> LoopbackTransport::CreatePair()
+{
+  std::shared_ptr<Channel> channel = std::make_shared<Channel>();
+  return { std::unique_ptr<LoopbackTransport>(new LoopbackTransport(channel, 0)),
+    std::unique_ptr<LoopbackTransport>(new LoopbackTransport(channel, 1)) };
+}
+
+//______________________________________________________________________________
+bool LoopbackTransport::Send(const void* data, size_t size)
+{
+  const char* bytes = static_cast<const char*>(data);
+  std::lock_guard lock(_channel->mutex);
+  _channel->packets[1 - _side].emplace_back(bytes, bytes + size);
+  return true;
+}
+
+//______________________________________________________________________________
+size_t LoopbackTransport::Receive(void* data, size_t capacity)
+{
+  std::lock_guard lock(_channel->mutex);
+  std::deque<std::vector<char>>& queue = _channel->packets[_side];
+  if (queue.empty())
+    return 0;
+
+  // like a datagram socket, anything past the capacity is cut off
+  const size_t size = std::min(queue.front().size(), capacity);
+  std::memcpy(data, queue.front().data(), size);
+  queue.pop_front();
+  return size;
+}
+
+//______________________________________________________________________________
+UdpTransport::UdpTransport(unsigned short localPort, const std::string& remoteAddress, unsigned short remotePort)
+{
+#ifdef _WIN32
+  WSADATA wd = { 0 };
+  WSAStartup(MAKEWORD(2, 2), &wd);
+#endif
+
+  sockaddr_in remote = {};
+  remote.sin_family = AF_INET;
+  remote.sin_port = htons(remotePort);
+  if (inet_pton(AF_INET, remoteAddress.c_str(), &remote.sin_addr) != 1)
+    return;
+  std::memcpy(_remote, &remote, sizeof(remote));
+
+  const SocketHandle handle = static_cast<SocketHandle>(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+#ifdef _WIN32
+  if (handle == static_cast<SocketHandle>(INVALID_SOCKET))
+    return;
+#else
+  if (handle < 0)
+    return;
+#endif
+
+  // listen on the loopback interface when talking to a local peer, otherwise on every interface
+  sockaddr_in local = {};
+  local.sin_family = AF_INET;
+  local.sin_port = htons(localPort);
+  local.sin_addr.s_addr = remoteAddress == "127.0.0.1" ? htonl(INADDR_LOOPBACK) : htonl(INADDR_ANY);
+
+#ifdef _WIN32
+  const SOCKET native = static_cast<SOCKET>(handle);
+  u_long nonBlocking = 1;
+  const bool ok = bind(native, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0 && ioctlsocket(native, FIONBIO, &nonBlocking) == 0;
+  if (!ok)
+  {
+    closesocket(native);
+    return;
+  }
+#else
+  const int native = static_cast<int>(handle);
+  const bool ok = bind(native, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0 && fcntl(native, F_SETFL, fcntl(native, F_GETFL, 0) | O_NONBLOCK) == 0;
+  if (!ok)
+  {
+    close(native);
+    return;
+  }
+#endif
+
+  _socket = handle;
+}
+
+//______________________________________________________________________________
+UdpTransport::~UdpTransport()
+{
+#ifdef _WIN32
+  if (IsOpen())
+    closesocket(static_cast<SOCKET>(_socket));
+  WSACleanup();
+#else
+  if (IsOpen())
+    close(static_cast<int>(_socket));
+#endif
+}
+
+//______________________________________________________________________________
+std::pair<std::unique_ptr<UdpTransport>, std::unique_ptr<UdpTransport>> UdpTransport::CreateLocalPair(unsigned short portA, unsigned short portB)
+{
+  return { std::make_unique<UdpTransport>(portA, "127.0.0.1", portB), std::make_unique<UdpTransport>(portB, "127.0.0.1", portA) };
+}
+
+//______________________________________________________________________________
+bool UdpTransport::Send(const void* data, size_t size)
+{
+  if (!IsOpen())
+    return false;
+
+#ifdef _WIN32
+  const int sent = sendto(static_cast<SOCKET>(_socket), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<const sockaddr*>(_remote), sizeof(sockaddr_in));
+#else
+  const ssize_t sent = sendto(static_cast<int>(_socket), data, size, 0, reinterpret_cast<const sockaddr*>(_remote), sizeof(sockaddr_in));
+#endif
+  return sent == static_cast<std::remove_const_t<decltype(sent)>>(size);
+}
+
+//______________________________________________________________________________
+size_t UdpTransport::Receive(void* data, size_t capacity)
+{
+  if (!IsOpen())
+    return 0;
+
+  sockaddr_in remote;
+  std::memcpy(&remote, _remote, sizeof(remote));
+
+  // only the remote this sends to is listened to, datagrams from anyone else are dropped and the next one is read
+  while (true)
+  {
+    sockaddr_in from = {};
+#ifdef _WIN32
+    int fromSize = sizeof(from);
+    const int received = recvfrom(static_cast<SOCKET>(_socket), static_cast<char*>(data), static_cast<int>(capacity), 0, reinterpret_cast<sockaddr*>(&from), &fromSize);
+#else
+    socklen_t fromSize = sizeof(from);
+    const ssize_t received = recvfrom(static_cast<int>(_socket), data, capacity, 0, reinterpret_cast<sockaddr*>(&from), &fromSize);
+#endif
+    // nothing waiting (would block) or an error such as the peer not listening yet
+    if (received <= 0)
+      return 0;
+
+    if (from.sin_family == AF_INET && from.sin_addr.s_addr == remote.sin_addr.s_addr && from.sin_port == remote.sin_port)
+      return static_cast<size_t>(received);
+  }
+}
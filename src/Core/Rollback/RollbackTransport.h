@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+//______________________________________________________________________________
+//! Unreliable datagram link to the remote peer of a rollback session. Packets may be dropped, duplicated or arrive out
+//! of order, the session copes with that by resending unacknowledged inputs
+class IRollbackTransport
+{
+public:
+  virtual ~IRollbackTransport() {}
+  //! Sends one packet without blocking. Returns false if it could not be sent (it is simply lost)
+  virtual bool Send(const void* data, size_t size) = 0;
+  //! Copies the next received packet into data without blocking. Returns its size, or 0 if nothing has arrived
+  virtual size_t Receive(void* data, size_t capacity) = 0;
+};
+
+//______________________________________________________________________________
+//! In-process link. Both ends share a pair of queues so two sessions in the same process (or thread) can talk
+//! without a network
+class LoopbackTransport : public IRollbackTransport
+{
+public:
+  //! Creates both ends of a link
+  static std::pair<std::unique_ptr<LoopbackTransport>, std::unique_ptr<LoopbackTransport>> CreatePair();
+
+  bool Send(const void* data, size_t size) override;
+  size_t Receive(void* data, size_t capacity) override;
+
+private:
+  struct Channel
+  {
+    std::mutex mutex;
+    //! Packets waiting to be received by each end
+    std::deque<std::vector<char>> packets[2];
+  };
+
+  LoopbackTransport(std::shared_ptr<Channel> channel, int side) : _channel(std::move(channel)), _side(side) {}
+
+  std::shared_ptr<Channel> _channel;
+  //! End of the channel this is (0 or 1)
+  int _side;
+
+};
+
+//______________________________________________________________________________
+//! Non blocking UDP socket bound to a local port, sending to a single remote address and only receiving from it
+class UdpTransport : public IRollbackTransport
+{
+public:
+  UdpTransport(unsigned short localPort, const std::string& remoteAddress, unsigned short remotePort);
+  ~UdpTransport();
+
+  //! Creates two ends talking over 127.0.0.1
+  static std::pair<std::unique_ptr<UdpTransport>, std::unique_ptr<UdpTransport>> CreateLocalPair(unsigned short portA, unsigned short portB);
+
+  //! Whether the socket was created and bound
+  bool IsOpen() const { return _socket != InvalidSocket; }
+
+  bool Send(const void* data, size_t size) override;
+  size_t Receive(void* data, size_t capacity) override;
+
+private:
+  UdpTransport(const UdpTransport&) = delete;
+  UdpTransport operator=(const UdpTransport&) = delete;
+
+  //! Native socket handle (SOCKET on windows, file descriptor elsewhere)
+  using SocketHandle = intptr_t;
+  static constexpr SocketHandle InvalidSocket = -1;
+
+  SocketHandle _socket = InvalidSocket;
+  //! Remote address as a sockaddr_in, kept opaque so the header doesn't pull in the socket headers
+  alignas(8) unsigned char _remote[16] = {};
+
+};
@@ -0,0 +1,90 @@
+#include "Core/Rollback/SnapshotIndex.h"
+#include "Core/Utility/FastHash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+namespace
+{
+  uint64_t SectionKey(uint32_t entity, int part) { return (static_cast<uint64_t>(entity) << 32) | static_cast<uint32_t>(part); }
+}
+
+//______________________________________________________________________________
+void SnapshotIndex::Mark(std::ostream& os, uint32_t entity, int part)
+{
+  const std::streamoff position = os.tellp();
+  assert(position >= 0 && "Snapshot stream has to report its write position");
+  Mark(static_cast<size_t>(std::max<std::streamoff>(position, 0)), entity, part);
+}
+
+//______________________________________________________________________________
+void SnapshotIndex::Mark(size_t offset, uint32_t entity, int part)
+{
+  assert((_sections.empty() || _sections.back().offset <= offset) && "Snapshot sections have to be marked in order");
+
+  // sizes are filled in by Finish, once the end of every section is known
+  _sections.push_back(Section{ entity, part, static_cast<uint32_t>(offset), 0, 0 });
+}
+
+//______________________________________________________________________________
+uint64_t SnapshotIndex::Finish(const char* data, size_t size)
+{
+  if (_sections.empty() || _sections.front().offset > 0)
+    _sections.insert(_sections.begin(), Section{ NoEntity, Header, 0, 0, 0 });
+
+  _hash = 0;
+  for (size_t i = 0; i < _sections.size(); i++)
+  {
+    Section& section = _sections[i];
+    const size_t end = i + 1 < _sections.size() ? _sections[i + 1].offset : size;
+    section.size = static_cast<uint32_t>(end - section.offset);
+    section.hash = FastHash64(data + section.offset, section.size);
+    _hash = HashCombine(_hash, section.hash);
+  }
+  return _hash;
+}
+
+//______________________________________________________________________________
+std::vector<SnapshotIndex::Mismatch> SnapshotIndex::Compare(const SnapshotIndex& expected, const char* expectedData, const SnapshotIndex& actual,
+  const char* actualData, size_t maxMismatches)
+{
+  std::vector<Mismatch> mismatches;
+
+  std::unordered_map<uint64_t, size_t> actualSections;
+  for (size_t i = 0; i < actual._sections.size(); i++)
+    actualSections.emplace(SectionKey(actual._sections[i].entity, actual._sections[i].part), i);
+
+  std::vector<bool> matched(actual._sections.size(), false);
+  for (const Section& want : expected._sections)
+  {
+    if (mismatches.size() >= maxMismatches)
+      return mismatches;
+
+    auto it = actualSections.find(SectionKey(want.entity, want.part));
+    if (it == actualSections.end())
+    {
+      mismatches.push_back(Mismatch{ Mismatch::Type::Missing, want.entity, want.part, 0, want.size, 0 });
+      continue;
+    }
+
+    const Section& got = actual._sections[it->second];
+    matched[it->second] = true;
+    if (got.hash == want.hash && got.size == want.size)
+      continue;
+
+    // first byte that differs, or the end of the shorter one if one is a prefix of the other
+    const uint32_t common = std::min(want.size, got.size);
+    const char* a = expectedData + want.offset;
+    const char* b = actualData + got.offset;
+    const uint32_t byte = static_cast<uint32_t>(std::mismatch(a, a + common, b).first - a);
+    mismatches.push_back(Mismatch{ Mismatch::Type::Differs, want.entity, want.part, byte, want.size, got.size });
+  }
+
+  for (size_t i = 0; i < actual._sections.size() && mismatches.size() < maxMismatches; i++)
+  {
+    if (!matched[i])
+      mismatches.push_back(Mismatch{ Mismatch::Type::Extra, actual._sections[i].entity, actual._sections[i].part, 0, 0, actual._sections[i].size });
+  }
+  return mismatches;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+//______________________________________________________________________________
+//! Layout of a snapshot: which entity and component wrote each range of bytes, and a hash of each range. The game
+//! marks where every part starts while it serializes and the hashes are taken once the snapshot is complete. Two
+//! snapshots of the same state have the same sections, so a checksum mismatch can be narrowed down to the component
+//! and byte that differs without deserializing anything
+class SnapshotIndex
+{
+public:
+  //! Entity of sections that don't belong to one
+  static constexpr uint32_t NoEntity = 0xFFFFFFFF;
+  //! Part of the data written before any entity (scene, frame stop...)
+  static constexpr int Header = -2;
+  //! Part of an entity written before its components (ID and signature)
+  static constexpr int EntityHeader = -1;
+
+  struct Section
+  {
+    uint32_t entity;
+    //! Component ID, or Header/EntityHeader
+    int part;
+    uint32_t offset;
+    uint32_t size;
+    uint64_t hash;
+  };
+
+  struct Mismatch
+  {
+    enum class Type { Differs, Missing, Extra };
+
+    Type type;
+    uint32_t entity;
+    int part;
+    //! First byte that differs, relative to the start of the section (Differs only)
+    uint32_t byteOffset;
+    //! Section sizes in the expected and actual snapshots (0 when the section isn't there)
+    uint32_t expectedSize;
+    uint32_t actualSize;
+  };
+
+  //! Drops the sections, keeping their memory
+  void Clear() { _sections.clear(); _hash = 0; }
+  //! Starts a section for the part of the entity at the current end of the stream. The previous section ends there
+  void Mark(std::ostream& os, uint32_t entity, int part);
+  //! Starts a section for the part of the entity at offset, for data written without going through the stream. Marks
+  //! have to be made in the order of their offsets
+  void Mark(size_t offset, uint32_t entity, int part);
+  //! Ends the last section at size, then hashes every section of the data. Returns the combined hash. Data that was
+  //! written without any marks becomes a single header section
+  uint64_t Finish(const char* data, size_t size);
+
+  const std::vector<Section>& Sections() const { return _sections; }
+  //! Combined hash of all sections, valid after Finish
+  uint64_t Hash() const { return _hash; }
+
+  //! Lists the sections that differ between two snapshots, in the expected snapshot's order. The data is what each index
+  //! was built over. Stops after maxMismatches
+  static std::vector<Mismatch> Compare(const SnapshotIndex& expected, const char* expectedData, const SnapshotIndex& actual,
+    const char* actualData, size_t maxMismatches = 16);
+
+private:
+  std::vector<Section> _sections;
+  uint64_t _hash = 0;
+
+};
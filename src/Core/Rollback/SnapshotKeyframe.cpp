@@ -0,0 +1,67 @@
+#include "Core/Rollback/SnapshotKeyframe.h"
+
+#include <algorithm>
+#include <cstring>
+
+//______________________________________________________________________________
+void SnapshotKeyframe::Reset(int frame)
+{
+  _frame = frame;
+  _nArrays = 0;
+}
+
+//______________________________________________________________________________
+void SnapshotKeyframe::AddArray(int part, const char* data, size_t size)
+{
+  if (_nArrays == _arrays.size())
+    _arrays.emplace_back();
+  Array& array = _arrays[_nArrays++];
+  array.part = part;
+  array.data.assign(data, data + size);
+  std::fill(array.runs.begin(), array.runs.end(), NoRun);
+
+  uint32_t count = 0;
+  if (size < sizeof(count))
+    return;
+  std::memcpy(&count, data, sizeof(count));
+  if (count == 0)
+    return;
+
+  const size_t ownersOffset = sizeof(count);
+  const size_t runsOffset = ownersOffset + count * sizeof(EntityID);
+  const size_t runSize = (size - runsOffset) / count;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    EntityID entity = 0;
+    std::memcpy(&entity, data + ownersOffset + i * sizeof(EntityID), sizeof(EntityID));
+    if (entity >= array.runs.size())
+      array.runs.resize(static_cast<size_t>(entity) + 1, NoRun);
+    array.runs[entity] = static_cast<uint32_t>(runsOffset + i * runSize);
+  }
+}
+
+//______________________________________________________________________________
+const std::vector<char>* SnapshotKeyframe::FindArray(int part) const
+{
+  for (size_t i = 0; i < _nArrays; i++)
+  {
+    if (_arrays[i].part == part)
+      return &_arrays[i].data;
+  }
+  return nullptr;
+}
+
+//______________________________________________________________________________
+const char* SnapshotKeyframe::FindRun(int part, EntityID entity) const
+{
+  for (size_t i = 0; i < _nArrays; i++)
+  {
+    const Array& array = _arrays[i];
+    if (array.part != part)
+      continue;
+    if (entity >= array.runs.size() || array.runs[entity] == NoRun)
+      return nullptr;
+    return array.data.data() + array.runs[entity];
+  }
+  return nullptr;
+}
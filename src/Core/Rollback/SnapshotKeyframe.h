@@ -0,0 +1,48 @@
+#pragma once
+#include "Globals.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//______________________________________________________________________________
+//! Reference state that delta snapshots are written against. Keeps the parts of a full snapshot that are written as
+//! arrays of same-sized runs (a count, the owning entities, then the runs) along with where each entity's run is. A
+//! delta snapshot leaves out every run that matches the keyframe, and loading it puts the keyframe's runs back before
+//! applying the ones the delta has. Memory is kept from one keyframe to the next
+class SnapshotKeyframe
+{
+public:
+  static constexpr int NoFrame = -1;
+
+  //! Drops the arrays and stamps the keyframe with the frame it is taken at
+  void Reset(int frame);
+  //! Frame the keyframe was taken at, NoFrame if it holds nothing
+  int Frame() const { return _frame; }
+
+  //! Copies the array section written for the part
+  void AddArray(int part, const char* data, size_t size);
+  //! Array section of the part, nullptr if the keyframe doesn't have it
+  const std::vector<char>* FindArray(int part) const;
+  //! Run of the entity in the part's array, nullptr if it doesn't have one
+  const char* FindRun(int part, EntityID entity) const;
+
+private:
+  //! Offset of an entity without a run
+  static constexpr uint32_t NoRun = 0xFFFFFFFF;
+
+  struct Array
+  {
+    int part = 0;
+    //! Section as written
+    std::vector<char> data;
+    //! Offset of each entity's run in data, indexed by entity ID
+    std::vector<uint32_t> runs;
+  };
+
+  int _frame = NoFrame;
+  //! Arrays in use are the first _nArrays, the rest are kept for their memory
+  std::vector<Array> _arrays;
+  size_t _nArrays = 0;
+
+};
@@ -0,0 +1,43 @@
+#include "Core/Rollback/SnapshotRing.h"
+
+#include <cassert>
+
+//______________________________________________________________________________
+void SnapshotRing::Allocate(size_t nSlots, size_t slotCapacity)
+{
+  _slots.clear();
+  _slots.reserve(nSlots);
+  for (size_t i = 0; i < nSlots; i++)
+    _slots.push_back(std::make_unique<Slot>(slotCapacity));
+}
+
+//______________________________________________________________________________
+void SnapshotRing::Commit(Slot& slot, int frame)
+{
+  assert(frame >= 0);
+
+  slot.frame = frame;
+  const uint64_t hash = slot.index.Finish(slot.writer.Data(), slot.writer.Size());
+  slot.checksum = static_cast<int>(static_cast<uint32_t>(hash ^ (hash >> 32)));
+}
+
+//______________________________________________________________________________
+const SnapshotRing::Slot* SnapshotRing::Find(int frame) const
+{
+  if (!Allocated() || frame < 0)
+    return nullptr;
+
+  const Slot& slot = *_slots[static_cast<size_t>(frame) % _slots.size()];
+  return slot.frame == frame ? &slot : nullptr;
+}
+
+//______________________________________________________________________________
+const SnapshotRing::Slot* SnapshotRing::FindByData(const char* data) const
+{
+  for (const std::unique_ptr<Slot>& slot : _slots)
+  {
+    if (slot->frame >= 0 && slot->writer.Data() == data)
+      return slot.get();
+  }
+  return nullptr;
+}
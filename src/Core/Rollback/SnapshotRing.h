@@ -0,0 +1,65 @@
+#pragma once
+#include "Core/Rollback/SnapshotIndex.h"
+#include "Core/Utility/SnapshotArena.h"
+
+#include <memory>
+#include <vector>
+
+//______________________________________________________________________________
+//! Fixed ring of game state snapshots indexed by frame number. Slots are allocated once when a session starts and
+//! snapshots are serialized straight into them, so saving and loading during rollback never touches the allocator.
+//! A saved frame stays valid until the frame NumSlots() later is saved over it, so size it to max prediction + 2
+//! (the same window GGPO keeps its saved states for)
+class SnapshotRing
+{
+public:
+  struct Slot
+  {
+    //! Arena the state is serialized into
+    SnapshotWriter writer;
+    //! Where each entity and component was written in the arena, with their hashes
+    SnapshotIndex index;
+    //! Frame stored in this slot, -1 if empty
+    int frame = -1;
+    //! Checksum of the stored bytes (the index's combined hash folded to 32 bits)
+    int checksum = 0;
+
+    explicit Slot(size_t capacity) : writer(capacity) {}
+  };
+
+  //! Allocates nSlots slots of slotCapacity bytes. Any saved frames are dropped
+  void Allocate(size_t nSlots, size_t slotCapacity);
+  //! Frees the slots (end of session)
+  void Release() { _slots.clear(); }
+  //! Whether slots have been allocated
+  bool Allocated() const { return !_slots.empty(); }
+  size_t NumSlots() const { return _slots.size(); }
+
+  //! Runs serialize(SnapshotWriter&, SnapshotIndex&) to write the game state into the slot of frame, marking its
+  //! sections in the index, then hashes it
+  template <typename Fn>
+  Slot& Save(int frame, Fn&& serialize);
+  //! Slot holding the frame, or nullptr if it was never saved or has been overwritten
+  const Slot* Find(int frame) const;
+  //! Slot whose arena holds the data (a buffer handed out from Save), or nullptr
+  const Slot* FindByData(const char* data) const;
+
+private:
+  //! Stamps the slot with the frame and hashes what was written
+  void Commit(Slot& slot, int frame);
+
+  //! Slots are kept behind pointers so their arenas never move
+  std::vector<std::unique_ptr<Slot>> _slots;
+
+};
+
+//______________________________________________________________________________
+template <typename Fn>
+inline SnapshotRing::Slot& SnapshotRing::Save(int frame, Fn&& serialize)
+{
+  Slot& slot = *_slots[static_cast<size_t>(frame) % _slots.size()];
+  slot.index.Clear();
+  serialize(slot.writer, slot.index);
+  Commit(slot, frame);
+  return slot;
+}
@@ -0,0 +1,273 @@
+#include "Core/Rollback/SpectatorRelay.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+  long long MicrosecondsSince(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  //! Largest packet either side sends
+  constexpr size_t MaxPacketSize = std::max({ sizeof(SpectatorProtocol::Request), sizeof(SpectatorProtocol::StateChunk), sizeof(SpectatorProtocol::Inputs) });
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::AddSpectator(std::unique_ptr<IRollbackTransport> transport)
+{
+  _spectators.push_back(Spectator{ std::move(transport), Stats() });
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::Reset()
+{
+  _inputs.clear();
+  _stateFrame = SpectatorProtocol::NoFrame;
+  _state.clear();
+  _pendingFrame = SpectatorProtocol::NoFrame;
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::Update(const RollbackSession& session, bool canWriteState, const StateWriter& writeState)
+{
+  // inputs come in confirmed frame by frame, so they are only ever appended
+  InputState frameInputs[SpectatorProtocol::NumPlayers];
+  while (session.GetConfirmedInputs(static_cast<int>(_inputs.size() / SpectatorProtocol::NumPlayers), frameInputs))
+    _inputs.insert(_inputs.end(), frameInputs, frameInputs + SpectatorProtocol::NumPlayers);
+
+  if (_pendingFrame != SpectatorProtocol::NoFrame)
+    CheckPendingState();
+
+  const int frame = session.GetCurrentFrame();
+  const bool stateDue = _stateFrame == SpectatorProtocol::NoFrame || frame - _stateFrame >= StateInterval;
+  if (stateDue && canWriteState && _pendingFrame == SpectatorProtocol::NoFrame)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    writeState(_pendingState);
+    _stateMicroseconds = MicrosecondsSince(start);
+    // spectators would turn it down
+    assert(_pendingState.size() <= SpectatorProtocol::MaxStateSize && "Spectator state is too large.");
+
+    // what the frames that aren't confirmed yet ran with
+    _pendingInputs.clear();
+    bool kept = true;
+    for (int f = static_cast<int>(_inputs.size() / SpectatorProtocol::NumPlayers); f < frame && kept; f++)
+    {
+      kept = session.GetSimulatedInputs(f, frameInputs);
+      _pendingInputs.insert(_pendingInputs.end(), frameInputs, frameInputs + SpectatorProtocol::NumPlayers);
+    }
+    if (kept)
+    {
+      _pendingFrame = frame;
+      CheckPendingState();
+    }
+  }
+
+  for (Spectator& spectator : _spectators)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    Serve(spectator);
+    spectator.stats.frames++;
+    spectator.stats.microseconds += MicrosecondsSince(start);
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::CheckPendingState()
+{
+  const size_t pendingEnd = static_cast<size_t>(_pendingFrame) * SpectatorProtocol::NumPlayers;
+  const size_t pendingStart = pendingEnd - _pendingInputs.size();
+  const size_t confirmedEnd = std::min(_inputs.size(), pendingEnd);
+
+  // dropped as soon as one of the inputs confirmed so far differs
+  if (!std::equal(_inputs.begin() + pendingStart, _inputs.begin() + confirmedEnd, _pendingInputs.begin()))
+    _pendingFrame = SpectatorProtocol::NoFrame;
+  else if (confirmedEnd == pendingEnd)
+  {
+    _state.swap(_pendingState);
+    _stateFrame = _pendingFrame;
+    _pendingFrame = SpectatorProtocol::NoFrame;
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::Serve(Spectator& spectator)
+{
+  // only the latest request matters, each one says everything the spectator is missing
+  SpectatorProtocol::Request request;
+  bool requested = false;
+  char packet[MaxPacketSize];
+  size_t size = 0;
+  while ((size = spectator.transport->Receive(packet, sizeof(packet))) > 0)
+  {
+    if (size < sizeof(SpectatorProtocol::Request) || static_cast<SpectatorProtocol::Type>(packet[0]) != SpectatorProtocol::Type::Request)
+      continue;
+    std::memcpy(&request, packet, sizeof(request));
+    requested = true;
+  }
+  if (!requested)
+    return;
+
+  if (!request.hasState)
+  {
+    spectator.stats.lastFrame = SpectatorProtocol::NoFrame;
+    if (_stateFrame == SpectatorProtocol::NoFrame)
+      return;
+
+    // a newer state was taken since the spectator started on its one, start over on the new one
+    uint32_t offset = request.stateFrame == _stateFrame ? request.stateReceived : 0;
+    SpectatorProtocol::StateChunk chunk;
+    chunk.type = SpectatorProtocol::Type::StateChunk;
+    chunk.frame = _stateFrame;
+    chunk.totalSize = static_cast<uint32_t>(_state.size());
+    for (int i = 0; i < ChunksPerFrame && offset < _state.size(); i++)
+    {
+      chunk.offset = offset;
+      chunk.size = static_cast<uint16_t>(std::min<size_t>(SpectatorProtocol::ChunkSize, _state.size() - offset));
+      std::memcpy(chunk.data, _state.data() + offset, chunk.size);
+      Send(spectator, &chunk, offsetof(SpectatorProtocol::StateChunk, data) + chunk.size);
+      offset += chunk.size;
+    }
+    return;
+  }
+
+  spectator.stats.lastFrame = request.lastFrame;
+  const int confirmedFrames = static_cast<int>(_inputs.size() / SpectatorProtocol::NumPlayers);
+  SpectatorProtocol::Inputs inputs;
+  inputs.type = SpectatorProtocol::Type::Inputs;
+  int frame = std::max(request.lastFrame + 1, 0);
+  for (int i = 0; i < InputPacketsPerFrame && frame < confirmedFrames; i++)
+  {
+    inputs.startFrame = frame;
+    inputs.count = static_cast<uint8_t>(std::min(confirmedFrames - frame, SpectatorProtocol::MaxFramesPerPacket));
+    std::copy_n(&_inputs[static_cast<size_t>(frame) * SpectatorProtocol::NumPlayers], inputs.count * SpectatorProtocol::NumPlayers, inputs.inputs);
+    Send(spectator, &inputs, offsetof(SpectatorProtocol::Inputs, inputs) + inputs.count * SpectatorProtocol::NumPlayers * sizeof(InputState));
+    frame += inputs.count;
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorRelay::Send(Spectator& spectator, const void* data, size_t size)
+{
+  spectator.transport->Send(data, size);
+  spectator.stats.bytesSent += static_cast<long long>(size);
+  spectator.stats.packetsSent++;
+}
+
+//______________________________________________________________________________
+SpectatorSession::SpectatorSession(IRollbackGame& game, std::unique_ptr<IRollbackTransport> transport) :
+  _game(game), _transport(std::move(transport)) {}
+
+//______________________________________________________________________________
+int SpectatorSession::Tick()
+{
+  Receive();
+  SendRequest();
+  if (!_hasState)
+    return 0;
+
+  const int buffered = FramesBuffered();
+  const int frames = buffered > CatchUpThreshold ? std::min(buffered, MaxFramesPerTick) : std::min(buffered, 1);
+  for (int i = 0; i < frames; i++)
+  {
+    // only the last frame of the call is shown
+    const SimulationPhase phase = i + 1 < frames ? SimulationPhase::Resimulate : SimulationPhase::Present;
+    _game.AdvanceFrame(&_inputs[static_cast<size_t>(_currentFrame - _stateFrame) * SpectatorProtocol::NumPlayers], phase);
+    _currentFrame++;
+  }
+  return frames;
+}
+
+//______________________________________________________________________________
+void SpectatorSession::Receive()
+{
+  char packet[MaxPacketSize];
+  size_t size = 0;
+  while ((size = _transport->Receive(packet, sizeof(packet))) > 0)
+  {
+    const SpectatorProtocol::Type type = static_cast<SpectatorProtocol::Type>(packet[0]);
+    if (type == SpectatorProtocol::Type::StateChunk && size >= offsetof(SpectatorProtocol::StateChunk, data))
+    {
+      SpectatorProtocol::StateChunk chunk;
+      std::memcpy(&chunk, packet, std::min(size, sizeof(chunk)));
+      OnStateChunk(chunk, size);
+    }
+    else if (type == SpectatorProtocol::Type::Inputs && size >= offsetof(SpectatorProtocol::Inputs, inputs))
+    {
+      SpectatorProtocol::Inputs inputs;
+      std::memcpy(&inputs, packet, std::min(size, sizeof(inputs)));
+      OnInputs(inputs, size);
+    }
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorSession::OnStateChunk(const SpectatorProtocol::StateChunk& chunk, size_t size)
+{
+  if (_hasState || chunk.size > SpectatorProtocol::ChunkSize || size < offsetof(SpectatorProtocol::StateChunk, data) + chunk.size ||
+    chunk.totalSize > SpectatorProtocol::MaxStateSize)
+    return;
+
+  if (chunk.frame != _stateFrame)
+  {
+    _stateFrame = chunk.frame;
+    _state.assign(chunk.totalSize, 0);
+    _stateReceived = 0;
+  }
+
+  // chunks are taken in order, anything after a gap is asked for again
+  if (chunk.offset != _stateReceived || chunk.totalSize != _state.size() || _stateReceived + chunk.size > _state.size())
+    return;
+  std::memcpy(_state.data() + _stateReceived, chunk.data, chunk.size);
+  _stateReceived += chunk.size;
+
+  if (_stateReceived == _state.size())
+  {
+    // a state that doesn't load is thrown away and the join starts over from the host's current one
+    if (!_game.LoadGameState(_state.data(), _state.size()))
+    {
+      _stateFrame = SpectatorProtocol::NoFrame;
+      _state.clear();
+      _stateReceived = 0;
+      return;
+    }
+    _hasState = true;
+    _currentFrame = _stateFrame;
+    _lastFrame = _stateFrame - 1;
+    _inputs.clear();
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorSession::OnInputs(const SpectatorProtocol::Inputs& packet, size_t size)
+{
+  if (!_hasState || packet.count > SpectatorProtocol::MaxFramesPerPacket ||
+    size < offsetof(SpectatorProtocol::Inputs, inputs) + packet.count * SpectatorProtocol::NumPlayers * sizeof(InputState))
+    return;
+
+  for (int i = 0; i < packet.count; i++)
+  {
+    // same as the session: inputs are accepted in order
+    if (packet.startFrame + i != _lastFrame + 1)
+      continue;
+    _inputs.insert(_inputs.end(), &packet.inputs[i * SpectatorProtocol::NumPlayers], &packet.inputs[(i + 1) * SpectatorProtocol::NumPlayers]);
+    _lastFrame++;
+  }
+}
+
+//______________________________________________________________________________
+void SpectatorSession::SendRequest()
+{
+  SpectatorProtocol::Request request;
+  request.type = SpectatorProtocol::Type::Request;
+  request.hasState = _hasState ? 1 : 0;
+  request.stateFrame = _stateFrame;
+  request.stateReceived = static_cast<uint32_t>(_stateReceived);
+  request.lastFrame = _lastFrame;
+  _transport->Send(&request, sizeof(request));
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include "Core/Rollback/RollbackSession.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//______________________________________________________________________________
+//! Packets between the host of a rollback session and its spectators. A spectator asks for what it is missing every
+//! frame: the bytes of the state it joins from that it doesn't have yet, then the inputs after the last frame it has.
+//! The host only ever sends what was asked for, so a lost packet is simply asked for again
+struct SpectatorProtocol
+{
+  static constexpr int NumPlayers = RollbackSession::NumPlayers;
+  static constexpr int NoFrame = -1;
+  //! Bytes of state per chunk, small enough to not be fragmented
+  static constexpr int ChunkSize = 1024;
+  //! Most frames of input per packet
+  static constexpr int MaxFramesPerPacket = 32;
+  //! Largest state a spectator accepts. The size comes from the network, so it isn't trusted past this
+  static constexpr uint32_t MaxStateSize = 8 * 1024 * 1024;
+
+  enum class Type : uint8_t { Request, StateChunk, Inputs };
+
+  //! Spectator to host
+  struct Request
+  {
+    Type type;
+    //! Whether the spectator has a whole state and runs frames from it
+    uint8_t hasState;
+    //! State being received and the number of its bytes received in order (when hasState is 0)
+    int32_t stateFrame;
+    uint32_t stateReceived;
+    //! Last frame the spectator has the inputs of (when hasState is 1)
+    int32_t lastFrame;
+  };
+
+  //! Host to spectator, part of the state spectators join from
+  struct StateChunk
+  {
+    Type type;
+    int32_t frame;
+    uint32_t totalSize;
+    uint32_t offset;
+    uint16_t size;
+    char data[ChunkSize];
+  };
+
+  //! Host to spectator, confirmed inputs of both players
+  struct Inputs
+  {
+    Type type;
+    int32_t startFrame;
+    uint8_t count;
+    InputState inputs[MaxFramesPerPacket * NumPlayers];
+  };
+};
+
+//______________________________________________________________________________
+//! Host side. Keeps every confirmed input of the session and, now and then, a full state spectators join from.
+//! The state is taken at the current frame, which may have been predicted, along with the inputs it was simulated
+//! with. It is only handed out once those inputs are all confirmed unchanged, otherwise another one is taken.
+//! Spectators receive that state then the inputs from there, as fast as they ask for them. The host does nothing more
+//! per frame for a spectator than answering its request
+class SpectatorRelay
+{
+public:
+  //! Frames between two states spectators join from
+  static constexpr int StateInterval = 300;
+  //! Most state chunks and input packets sent to a spectator per frame
+  static constexpr int ChunksPerFrame = 8;
+  static constexpr int InputPacketsPerFrame = 4;
+
+  //! Writes the full state of the current frame, in whatever form the spectators' game loads it
+  using StateWriter = std::function<void(std::vector<char>& state)>;
+
+  //! Cost of a spectator on the host
+  struct Stats
+  {
+    //! Frames the host served it
+    int frames = 0;
+    long long bytesSent = 0;
+    int packetsSent = 0;
+    //! Time spent answering its requests
+    long long microseconds = 0;
+    //! Last frame it has the inputs of, NoFrame while it joins
+    int lastFrame = SpectatorProtocol::NoFrame;
+  };
+
+  void AddSpectator(std::unique_ptr<IRollbackTransport> transport);
+  void RemoveSpectators() { _spectators.clear(); }
+  //! Forgets the inputs and state, for a new session. Spectators are kept
+  void Reset();
+  int Spectators() const { return static_cast<int>(_spectators.size()); }
+  const Stats& GetStats(int spectator) const { return _spectators[spectator].stats; }
+
+  //! Call once per frame from the start of the session, after the frame ran. Records the inputs the session confirmed
+  //! since the last call, takes a new state when one is due (writeState is only called if canWriteState) and answers
+  //! the spectators
+  void Update(const RollbackSession& session, bool canWriteState, const StateWriter& writeState);
+
+  //! Frame of the state spectators join from, NoFrame if there isn't one yet
+  int StateFrame() const { return _stateFrame; }
+  size_t StateSize() const { return _state.size(); }
+  //! Time spent taking the last state
+  long long StateMicroseconds() const { return _stateMicroseconds; }
+
+private:
+  struct Spectator
+  {
+    std::unique_ptr<IRollbackTransport> transport;
+    Stats stats;
+  };
+
+  //! Takes the pending state as the one spectators join from if the inputs it was simulated with were all confirmed,
+  //! drops it if one of them wasn't
+  void CheckPendingState();
+  //! Reads the spectator's requests and sends what the last one asks for
+  void Serve(Spectator& spectator);
+  void Send(Spectator& spectator, const void* data, size_t size);
+
+  std::vector<Spectator> _spectators;
+
+  //! Confirmed inputs of both players from frame 0
+  std::vector<InputState> _inputs;
+  int _stateFrame = SpectatorProtocol::NoFrame;
+  std::vector<char> _state;
+  long long _stateMicroseconds = 0;
+  //! State taken before all the inputs it depends on were confirmed, and the inputs of the frames that weren't
+  int _pendingFrame = SpectatorProtocol::NoFrame;
+  std::vector<char> _pendingState;
+  std::vector<InputState> _pendingInputs;
+
+};
+
+//______________________________________________________________________________
+//! Spectator side. Asks the host for a state, loads it and runs the confirmed frames that follow without predicting or
+//! rolling back. It runs one frame per call while it keeps up and several when it is behind, which is how it catches
+//! up after joining from a state that is already a few seconds old
+class SpectatorSession
+{
+public:
+  //! Frames buffered before catching up kicks in, to ride out jitter
+  static constexpr int CatchUpThreshold = 6;
+  //! Most frames run per call when catching up
+  static constexpr int MaxFramesPerTick = 10;
+
+  //! The game loads the host's state (as written by its SpectatorRelay::StateWriter) and runs the frames. A frame run
+  //! to catch up isn't the last of its call so it runs as SimulationPhase::Resimulate
+  SpectatorSession(IRollbackGame& game, std::unique_ptr<IRollbackTransport> transport);
+
+  //! Call once per frame. Receives from the host, asks for what is missing and runs the frames that can run. Returns the
+  //! number of frames run
+  int Tick();
+
+  bool HasState() const { return _hasState; }
+  //! Frame that runs next
+  int GetCurrentFrame() const { return _currentFrame; }
+  //! Frames received but not run yet
+  int FramesBuffered() const { return _hasState ? _lastFrame + 1 - _currentFrame : 0; }
+  //! Bytes of the state received so far, and its size
+  size_t StateReceived() const { return _stateReceived; }
+  size_t StateSize() const { return _state.size(); }
+
+private:
+  void Receive();
+  void OnStateChunk(const SpectatorProtocol::StateChunk& chunk, size_t size);
+  void OnInputs(const SpectatorProtocol::Inputs& packet, size_t size);
+  void SendRequest();
+
+  IRollbackGame& _game;
+  std::unique_ptr<IRollbackTransport> _transport;
+
+  bool _hasState = false;
+  int _stateFrame = SpectatorProtocol::NoFrame;
+  std::vector<char> _state;
+  size_t _stateReceived = 0;
+
+  //! Inputs of both players from the state's frame on
+  std::vector<InputState> _inputs;
+  int _lastFrame = SpectatorProtocol::NoFrame;
+  int _currentFrame = 0;
+
+};
@@ -0,0 +1,173 @@
+#include "Core/Rollback/SyncTest.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace
+{
+  //! Initial size of each saved state, slots grow if a state doesn't fit
+  constexpr size_t SnapshotSlotCapacity = 64 * 1024;
+
+  long long MicrosecondsSince(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+//______________________________________________________________________________
+void SyncTest::Timing::Add(long long micros)
+{
+  count++;
+  totalMicroseconds += micros;
+  maxMicroseconds = std::max(maxMicroseconds, micros);
+}
+
+//______________________________________________________________________________
+SyncTest::SyncTest(IRollbackGame& game, const Config& config) : _game(game), _config(config)
+{
+  _config.frames = std::max(_config.frames, 0);
+  _config.rollbackFrames = std::max(_config.rollbackFrames, 0);
+}
+
+//______________________________________________________________________________
+SyncTest::Result SyncTest::Run(const InputSource& source)
+{
+  _result = Result();
+  RecordInputs(source);
+
+  // the rolled back frame and every frame after it up to the present, plus the one being saved
+  _snapshots.Allocate(static_cast<size_t>(_config.rollbackFrames) + 2, SnapshotSlotCapacity);
+
+  _startIndex.Clear();
+  _game.SaveGameState(0, _start, _startIndex);
+  RunStraight(false);
+
+  _game.LoadGameState(_start.Data(), _start.Size());
+  RunWithRollbacks();
+
+  _snapshots.Release();
+  return _result;
+}
+
+//______________________________________________________________________________
+SyncTest::Result SyncTest::Measure(const InputSource& source)
+{
+  _result = Result();
+  RecordInputs(source);
+
+  _snapshots.Allocate(2, SnapshotSlotCapacity);
+  RunStraight(true);
+  _result.framesRun = _config.frames;
+
+  _snapshots.Release();
+  return _result;
+}
+
+//______________________________________________________________________________
+void SyncTest::RecordInputs(const InputSource& source)
+{
+  _inputs.assign(static_cast<size_t>(_config.frames) * RollbackSession::NumPlayers, InputState::NONE);
+  for (int frame = 0; frame < _config.frames; frame++)
+    source(frame, &_inputs[static_cast<size_t>(frame) * RollbackSession::NumPlayers]);
+}
+
+//______________________________________________________________________________
+void SyncTest::RunStraight(bool measure)
+{
+  const size_t nStates = static_cast<size_t>(_config.frames) + 1;
+  _expected.resize(nStates);
+  _expectedIndexes.resize(nStates);
+  _expectedChecksums.resize(nStates);
+
+  auto record = [this, measure](int frame)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const SnapshotRing::Slot& slot = _snapshots.Save(frame, [this, frame](SnapshotWriter& writer, SnapshotIndex& index) { _game.SaveGameState(frame, writer, index); });
+    if (measure)
+    {
+      _result.save.Add(MicrosecondsSince(start));
+      _result.maxSnapshotBytes = std::max(_result.maxSnapshotBytes, slot.writer.Size());
+      _result.totalSnapshotBytes += slot.writer.Size();
+    }
+    _expected[frame].assign(slot.writer.Data(), slot.writer.Data() + slot.writer.Size());
+    _expectedIndexes[frame] = slot.index;
+    _expectedChecksums[frame] = slot.checksum;
+  };
+
+  record(0);
+  for (int frame = 0; frame < _config.frames; frame++)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    _game.AdvanceFrame(&_inputs[static_cast<size_t>(frame) * RollbackSession::NumPlayers], SimulationPhase::Present);
+    _result.presentFrame.Add(MicrosecondsSince(start));
+    record(frame + 1);
+  }
+}
+
+//______________________________________________________________________________
+void SyncTest::RunWithRollbacks()
+{
+  if (!SaveAndCompare(0, Result::NoFrame))
+    return;
+
+  for (int frame = 0; frame < _config.frames; frame++)
+  {
+    _game.AdvanceFrame(&_inputs[static_cast<size_t>(frame) * RollbackSession::NumPlayers], SimulationPhase::Present);
+    _result.framesRun++;
+
+    const int current = frame + 1;
+    if (!SaveAndCompare(current, Result::NoFrame))
+      return;
+
+    const int loadFrame = current - _config.rollbackFrames;
+    if (_config.rollbackFrames == 0 || loadFrame < 0)
+      continue;
+
+    const SnapshotRing::Slot* slot = _snapshots.Find(loadFrame);
+    assert(slot && "Rolled back further than the saved states go");
+
+    auto start = std::chrono::steady_clock::now();
+    _game.LoadGameState(slot->writer.Data(), slot->writer.Size());
+    _result.load.Add(MicrosecondsSince(start));
+    _result.rollbacks++;
+
+    // a state that doesn't survive a load shows up here, before any frame runs on top of it
+    if (!SaveAndCompare(loadFrame, loadFrame))
+      return;
+
+    long long resimulateMicros = 0;
+    for (int resimFrame = loadFrame; resimFrame < current; resimFrame++)
+    {
+      start = std::chrono::steady_clock::now();
+      _game.AdvanceFrame(&_inputs[static_cast<size_t>(resimFrame) * RollbackSession::NumPlayers], SimulationPhase::Resimulate);
+      const long long frameMicros = MicrosecondsSince(start);
+      _result.resimulatedFrame.Add(frameMicros);
+      resimulateMicros += frameMicros;
+
+      if (!SaveAndCompare(resimFrame + 1, loadFrame))
+        return;
+    }
+    _result.resimulate.Add(resimulateMicros);
+  }
+}
+
+//______________________________________________________________________________
+bool SyncTest::SaveAndCompare(int frame, int rolledBackFrom)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const SnapshotRing::Slot& slot = _snapshots.Save(frame, [this, frame](SnapshotWriter& writer, SnapshotIndex& index) { _game.SaveGameState(frame, writer, index); });
+  _result.save.Add(MicrosecondsSince(start));
+  _result.maxSnapshotBytes = std::max(_result.maxSnapshotBytes, slot.writer.Size());
+  _result.totalSnapshotBytes += slot.writer.Size();
+
+  if (slot.checksum == _expectedChecksums[frame])
+    return true;
+
+  _result.firstDivergentFrame = frame;
+  _result.divergentRollbackFrom = rolledBackFrom;
+  _result.expectedChecksum = _expectedChecksums[frame];
+  _result.actualChecksum = slot.checksum;
+  _result.mismatches = SnapshotIndex::Compare(_expectedIndexes[frame], _expected[frame].data(), slot.index, slot.writer.Data());
+  return false;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Core/Rollback/RollbackSession.h"
+
+#include <functional>
+#include <vector>
+
+//______________________________________________________________________________
+//! Checks that rolling back gives the same game as never rolling back. The game first runs straight through the
+//! inputs, checksumming the state of every frame. It is then reset to the start and, after every frame, loads the state
+//! from N frames back and resimulates to the present. Every state reached either way has to match the straight run.
+//! The first frame that doesn't is the first frame whose state isn't fully saved, loaded or deterministic. The
+//! resimulated frames run as SimulationPhase::Resimulate, so a system skipped on them that changes the saved state
+//! shows up as a divergence too
+class SyncTest
+{
+public:
+  //! Fills inputs (RollbackSession::NumPlayers long) with the inputs of the frame
+  using InputSource = std::function<void(int frame, InputState* inputs)>;
+
+  struct Config
+  {
+    //! Frames to simulate
+    int frames = 600;
+    //! Frames rolled back after every frame
+    int rollbackFrames = 7;
+  };
+
+  struct Timing
+  {
+    int count = 0;
+    long long totalMicroseconds = 0;
+    long long maxMicroseconds = 0;
+
+    double AverageMicroseconds() const { return count > 0 ? static_cast<double>(totalMicroseconds) / count : 0.0; }
+    void Add(long long micros);
+  };
+
+  struct Result
+  {
+    static constexpr int NoFrame = -1;
+
+    //! First frame whose state differs from the straight run, NoFrame if they all match
+    int firstDivergentFrame = NoFrame;
+    //! Frame the rollback that reached the divergent state loaded from, NoFrame if it was reached without rolling back
+    int divergentRollbackFrom = NoFrame;
+    //! Checksums of the divergent state in the straight run and when it was reached again
+    int expectedChecksum = 0;
+    int actualChecksum = 0;
+    //! Entities and components of the divergent state that differ from the straight run
+    std::vector<SnapshotIndex::Mismatch> mismatches;
+
+    //! Frames run by the checked pass (not counting resimulated ones)
+    int framesRun = 0;
+    int rollbacks = 0;
+    //! Largest saved state, and the bytes of every saved state for the average (over save.count)
+    size_t maxSnapshotBytes = 0;
+    size_t totalSnapshotBytes = 0;
+
+    //! Time spent saving a state
+    Timing save;
+    //! Time spent loading a state
+    Timing load;
+    //! Time spent resimulating the frames of one rollback (without the saves done along the way)
+    Timing resimulate;
+    //! Time spent running one frame of the straight run, and one resimulated frame
+    Timing presentFrame;
+    Timing resimulatedFrame;
+
+    bool Passed() const { return firstDivergentFrame == NoFrame; }
+  };
+
+  SyncTest(IRollbackGame& game, const Config& config);
+
+  //! Runs both passes from the game's current state. The game is left at the frame the test stopped on
+  Result Run(const InputSource& source);
+  //! Only runs the straight pass, to measure the states: their sizes, the time to save them and the time to run a
+  //! frame. Nothing is checked, so it works on a game that doesn't pass yet
+  Result Measure(const InputSource& source);
+
+private:
+  //! Records the inputs of every frame up front, so a random source gives both passes the same ones
+  void RecordInputs(const InputSource& source);
+  //! Runs the inputs straight through and records every frame's state. With measure, the saves are timed and sized
+  void RunStraight(bool measure);
+  //! Runs the inputs again from the start, rolling back after every frame. Stops at the first divergence
+  void RunWithRollbacks();
+  //! Saves the current state as the state of the frame and checks it against the straight run
+  bool SaveAndCompare(int frame, int rolledBackFrom);
+
+  IRollbackGame& _game;
+  Config _config;
+
+  //! Inputs of every frame, recorded so both passes see the same ones
+  std::vector<InputState> _inputs;
+  //! State at the start of each frame in the straight run (frames + 1 of them), kept to find what differs
+  std::vector<std::vector<char>> _expected;
+  //! Layout and hashes of those states
+  std::vector<SnapshotIndex> _expectedIndexes;
+  //! Checksum of those states
+  std::vector<int> _expectedChecksums;
+  //! State at the start of the test, both passes start from it
+  SnapshotWriter _start;
+  SnapshotIndex _startIndex;
+  //! States of the last frames of the checked pass
+  SnapshotRing _snapshots;
+
+  Result _result;
+
+};
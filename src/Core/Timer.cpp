@@ -2,8 +2,10 @@
 #include <SDL2/SDL.h>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include "Managers/GGPOManager.h"
+#include "Managers/RollbackManager.h"
 
 //______________________________________________________________________________
 SDLClock::SDLClock() : startTicks(0), pauseTicks(0), lag(0), paused(false), started(false) {}
@@ -72,21 +74,15 @@ void SDLClock::SetFPS()
 }
 
 //______________________________________________________________________________
-Timer::Coroutine::Coroutine(float time, UpdateFunction update) : _totalTime(time), _update(update)
-{
-  _clock.SetFPS();
-  _clock.Start();
-}
+Timer::Coroutine::Coroutine(int frames, UpdateFunction update) : _update(update), _totalFrames(std::max(frames, 1)), _elapsedFrames(0) {}
 
 //______________________________________________________________________________
-Timer::Coroutine::Status Timer::Coroutine::Update() const
+Timer::Coroutine::Status Timer::Coroutine::Update()
 {
-  _update(_clock.GetElapsedTimeSeconds() / _totalTime);
-
-  if(_clock.GetElapsedTimeSeconds() == 0.0f)
-    return Status::NotStarted;
+  _elapsedFrames++;
+  _update(static_cast<float>(_elapsedFrames) / static_cast<float>(_totalFrames));
 
-  if(_clock.GetElapsedTimeSeconds() / _totalTime >= 1.0f)
+  if (_elapsedFrames >= _totalFrames)
     return Status::Complete;
   return Status::Running;
 }
@@ -107,15 +103,12 @@ void Timer::Start(int fps)
 void Timer::BeginCoroutine(float seconds, UpdateFunction function)
 {
   // construct the event in place
-  _coroutines.emplace_back(seconds, function);
+  _coroutines.emplace_back(static_cast<int>(std::ceil(seconds / _mainClock.frametime)), function);
 }
 
 //______________________________________________________________________________
 void Timer::Update(UpdateFunction& updateFunction)
 {
-  // update all of the coroutines
-  UpdateCoroutines();
-
   uint32_t dt = _mainClock.GetElapsedTicks() - _lastFrameTime;
   _lastFrameTime = _mainClock.GetElapsedTicks();
   _mainClock.lag += dt;
@@ -138,6 +131,9 @@ void Timer::Update(UpdateFunction& updateFunction)
       _frames++;
       _mainClock.lag -= _mainClock.timestep;
 
+      // coroutines run on update frames, so they keep pace with the game
+      UpdateCoroutines();
+
       std::chrono::time_point<std::chrono::high_resolution_clock> tp1 = std::chrono::steady_clock::now();
       updateFunction(_mainClock.frametime);
 
@@ -157,10 +153,13 @@ void Timer::Update(UpdateFunction& updateFunction)
 #else
     SDL_Delay(delayMS);
 #endif
+    // pick up remote inputs that arrived while waiting
+    RollbackManager::Get().Idle();
     
   }
   else
   {
+    UpdateCoroutines();
     float dtS = static_cast<float>(dt) / 1000.0f;
     updateFunction(dtS);
   }
@@ -169,6 +168,15 @@ void Timer::Update(UpdateFunction& updateFunction)
 //______________________________________________________________________________
 void Timer::UpdateCoroutines()
 {
-  auto end = std::remove_if(_coroutines.begin(), _coroutines.end(), _coroutineUpdate);
-  _coroutines.erase(end, _coroutines.end());
+  size_t kept = 0;
+  for (size_t i = 0; i < _coroutines.size(); i++)
+  {
+    if (_coroutines[i].Update() == Coroutine::Status::Running)
+    {
+      if (kept != i)
+        _coroutines[kept] = std::move(_coroutines[i]);
+      kept++;
+    }
+  }
+  _coroutines.erase(_coroutines.begin() + kept, _coroutines.end());
 }
@@ -91,7 +91,7 @@ public:
   Timer() : _frames(0.0f), _fixedTimeStep(true), _lastFrameTime(_mainClock.now()) {}
   //! Start function gets the FPS from internal hardward
   void Start(int fps);
-  //! Begins a user custom coroutine function
+  //! Begins a user custom coroutine function, running for the update frames that fit in the time
   void BeginCoroutine(float seconds, UpdateFunction function);
   //! Updates timer and runs the user specified update function
   void Update(UpdateFunction& updateFunction);
@@ -99,29 +99,29 @@ public:
   long long GetUpdateTime() { return _perfCounter.Count(); }
 
 private:
-  //! coroutine class 
+  //! coroutine class. Counts fixed update frames rather than wall clock time, so it advances with the game
   class Coroutine
   {
   public:
     enum class Status
     {
-      NotStarted, Running, Complete
+      Running, Complete
     };
-    //! Intended to be constructed in place - timer is started on construction
-    Coroutine(float time, UpdateFunction update);
-    //! Update function should run once before the coroutine is removed
-    Status Update() const;
+    //! Intended to be constructed in place - runs for the given number of update frames
+    Coroutine(int frames, UpdateFunction update);
+    //! Moves the coroutine a frame on and calls the update function with its progress
+    Status Update();
 
   private:
     //! User assigned update function
     UpdateFunction _update;
-    //! Total time the coroutine should run for
-    float _totalTime;
-    //! Internal coroutine clock
-    SDLClock _clock;
+    //! Total frames the coroutine should run for
+    int _totalFrames;
+    //! Frames run so far
+    int _elapsedFrames;
   };
 
-  //! Updates all coroutines
+  //! Updates all coroutines by a frame
   void UpdateCoroutines();
 
   //! All frames elapsed
@@ -132,11 +132,6 @@ private:
   bool _fixedTimeStep;
   //! Running coroutines
   std::vector<Coroutine> _coroutines;
-  //! Function for removing coroutine from list as it updates
-  const std::function<bool(const Coroutine&)> _coroutineUpdate = [](const Coroutine& coroutine)
-  {
-    return coroutine.Update() == Coroutine::Status::Complete;
-  };
   //! Main clock
   SDLClock _mainClock;
   //! updates based on monitor refresh rate?
@@ -1,3 +0,0 @@
-#include "Core/Utility/DeferGuard.h"
-
-std::list<ScopeGuard> DeferredFn::List;
@@ -1,16 +1,11 @@
 #pragma once
-#include "Core/Utility/ScopeGuard.h"
-#include <list>
-
-struct DeferredFn
-{
-  static std::list<ScopeGuard> List;
-};
+#include "Core/ECS/EntityCommandBuffer.h"
 
+//! Applies everything recorded into the EntityCommandBuffer when the guard goes out of scope
 struct DeferGuard
 {
   DeferGuard() = default;
-  ~DeferGuard() { DeferredFn::List.clear(); }
+  ~DeferGuard() { EntityCommandBuffer::Get().Flush(); }
 };
 
 #define DEPAREN(X) ESC(ISH X)
@@ -20,4 +15,4 @@ struct DeferGuard
 #define VANISH
 
 //#define RunOnDeferGuardDestroy(capture, code) DeferredFn::List.emplace_back(CONCAT([DEPAREN(capture)](), { code ; }));
-#define RunOnDeferGuardDestroy(capture, code) DeferredFn::List.emplace_back([DEPAREN(capture)](){ code ; });
+#define RunOnDeferGuardDestroy(capture, code) EntityCommandBuffer::Get().Run([DEPAREN(capture)](){ code ; });
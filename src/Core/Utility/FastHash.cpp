@@ -0,0 +1,96 @@
+#include "Core/Utility/FastHash.h"
+
+#include <cstring>
+
+namespace
+{
+  constexpr uint64_t Prime1 = 11400714785074694791ULL;
+  constexpr uint64_t Prime2 = 14029467366897019727ULL;
+  constexpr uint64_t Prime3 = 1609587929392839161ULL;
+  constexpr uint64_t Prime4 = 9650029242287828579ULL;
+  constexpr uint64_t Prime5 = 2870177450012600261ULL;
+
+  inline uint64_t RotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+  inline uint64_t Read64(const unsigned char* p) { uint64_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+  inline uint32_t Read32(const unsigned char* p) { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+
+  inline uint64_t Round(uint64_t acc, uint64_t input)
+  {
+    acc += input * Prime2;
+    acc = RotateLeft(acc, 31);
+    return acc * Prime1;
+  }
+
+  inline uint64_t MergeRound(uint64_t acc, uint64_t lane)
+  {
+    acc ^= Round(0, lane);
+    return acc * Prime1 + Prime4;
+  }
+}
+
+//______________________________________________________________________________
+uint64_t FastHash64(const void* data, size_t size, uint64_t seed)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* const end = p + size;
+  uint64_t hash;
+
+  if (size >= 32)
+  {
+    // four lanes of 8 bytes
+    uint64_t v1 = seed + Prime1 + Prime2;
+    uint64_t v2 = seed + Prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - Prime1;
+
+    const unsigned char* const limit = end - 32;
+    do
+    {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  }
+  else
+  {
+    hash = seed + Prime5;
+  }
+
+  hash += static_cast<uint64_t>(size);
+
+  // tail
+  for (; p + 8 <= end; p += 8)
+  {
+    hash ^= Round(0, Read64(p));
+    hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+  }
+  if (p + 4 <= end)
+  {
+    hash ^= static_cast<uint64_t>(Read32(p)) * Prime1;
+    hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+    p += 4;
+  }
+  for (; p < end; p++)
+  {
+    hash ^= (*p) * Prime5;
+    hash = RotateLeft(hash, 11) * Prime1;
+  }
+
+  // avalanche
+  hash ^= hash >> 33;
+  hash *= Prime2;
+  hash ^= hash >> 29;
+  hash *= Prime3;
+  hash ^= hash >> 32;
+  return hash;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//______________________________________________________________________________
+//! 64 bit non-cryptographic hash of a byte range (the xxHash64 algorithm). Input is consumed 32 bytes at a time in
+//! four independent lanes, so the multiplies of one lane don't wait on the others and the loop runs close to memory
+//! speed. Reads are little endian, which every platform the engine runs on is
+uint64_t FastHash64(const void* data, size_t size, uint64_t seed = 0);
+
+//______________________________________________________________________________
+//! Mixes a value into a running hash. Order dependent, used to fold a list of hashes into one
+inline uint64_t HashCombine(uint64_t hash, uint64_t value)
+{
+  hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+  return hash;
+}
@@ -1,203 +1,161 @@
 #include "Core/Utility/InputSequenceBuffer.h"
-#include "Core/Utility/TypeTraits.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
 
-//______________________________________________________________________________
-void Serializer<std::list<InputState>>::Serialize(std::ostream& os, const std::list<InputState>& item)
-{
-  int inputSize = static_cast<int>(item.size());
-  Serializer<int>::Serialize(os, inputSize);
-  for (InputState input : item)
-  {
-    Serializer<InputState>::Serialize(os, input);
-  }
-}
-
-//______________________________________________________________________________
-void Serializer<std::list<InputState>>::Deserialize(std::istream& is, std::list<InputState>& item)
-{
-  int inputSize;
-  Serializer<int>::Deserialize(is, inputSize);
-
-  item.clear();
-  for (int i = 0; i < inputSize; i++)
-  {
-    InputState input;
-    Serializer<InputState>::Deserialize(is, input);
-    item.push_back(input);
-  }
-}
-
-//______________________________________________________________________________
-std::size_t BufferItem::operator()(BufferItem item) const
-{
-  std::size_t hash = 0;
-  for (auto& state : sequence)
-    hash_combine(hash, static_cast<std::size_t>(state));
-  return hash;
-}
+static_assert(std::is_trivially_copyable<InputState>::value && sizeof(InputState) == 1, "Directions are kept as the bytes of InputState");
 
 //______________________________________________________________________________
-bool operator<(const BufferItem& lhs, const BufferItem& rhs)
+SpecialMoveDictionary::SpecialMoveDictionary(std::initializer_list<std::pair<std::list<InputState>, SpecialInputState>> motions)
 {
-  if (lhs.sequence.size() < rhs.sequence.size())
-    return true;
-  if (lhs.sequence.size() > rhs.sequence.size())
-    return false;
-
-  auto it2 = rhs.sequence.begin();
-  for (auto it1 = lhs.sequence.begin(); it1 != lhs.sequence.end() && it2 != rhs.sequence.end(); ++it1, ++it2)
+  for (const auto& motion : motions)
   {
-    if (*it1 != *it2)
+    uint8_t node = Root;
+    for (InputState input : motion.first)
     {
-      return (int)*it1 < (int)*it2;
+      const uint8_t direction = static_cast<uint8_t>(input);
+      assert(direction < Directions && "Motions are made of directions only");
+
+      if (_nodes[node].next[direction] == NoNode)
+      {
+        assert(_count < MaxNodes && "Too many special move motions");
+        _nodes[_count].parent = node;
+        _nodes[_count].direction = direction;
+        _nodes[node].next[direction] = static_cast<uint8_t>(_count++);
+      }
+      node = _nodes[node].next[direction];
     }
+
+    _nodes[node].completes = true;
+    _nodes[node].value = motion.second;
   }
-  return true;
 }
 
 //______________________________________________________________________________
-void Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Serialize(std::ostream& os, const std::unordered_map<BufferItem, int, BufferItem>& item)
+InputSequenceBuffer::InputSequenceBuffer(int limit, const SpecialMoveDictionary& dict) : _dictionary(&dict), _limit(std::clamp(limit, 1, MaxLimit))
 {
-  // serialize the prefix map
-  int prefixMapSize = static_cast<int>(item.size());
-  Serializer<int>::Serialize(os, prefixMapSize);
-
-  // this always needs to be serialized in the same order
-  std::vector<BufferItem> orderedSet;
-  for (const auto& prefix : item)
-  {
-    orderedSet.push_back(prefix.first);
-  }
-
-  std::sort(orderedSet.begin(), orderedSet.end());
-
-  for (const BufferItem& key : orderedSet)
-  {
-    // serialize the key
-    Serializer<std::list<InputState>>::Serialize(os, key.sequence);
-    // serialize the lifetime
-    Serializer<int>::Serialize(os, item.at(key));
-  }
+  assert(limit <= MaxLimit && "Special move buffer is longer than it can hold");
+  Reset(_state);
+  _last = _state;
 }
 
 //______________________________________________________________________________
-void Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Deserialize(std::istream& is, std::unordered_map<BufferItem, int, BufferItem>& item)
+void InputSequenceBuffer::Reset(State& state) const
 {
-  // deserialize the prefix map
-  int prefixMapSize = 0;
-  Serializer<int>::Deserialize(is, prefixMapSize);
-  item.clear();
-  for (int i = 0; i < prefixMapSize; i++)
-  {
-    // deserialize the key
-    BufferItem key;
-    Serializer<std::list<InputState>>::Deserialize(is, key.sequence);
-
-    // deserialize the lifetime
-    int lifetime;
-    Serializer<int>::Deserialize(is, lifetime);
-
-    // add prefix to map
-    item[key] = lifetime;
-  }
+  std::fill(std::begin(state.ages), std::end(state.ages), NoAge);
+  std::fill(std::begin(state.directions), std::end(state.directions), static_cast<uint8_t>(0));
+  state.head = 0;
+  state.completed = SpecialMoveDictionary::Root;
+  state.latestInput = SpecialInputState::NONE;
 }
 
 //______________________________________________________________________________
 void InputSequenceBuffer::PushInput(const InputState& input)
 {
-  _latestCompletedSequence = {};
+  _last = _state;
 
   // only concerned with directional input here, so we just look at the bottom 4 bits
-  unsigned char chopped = (unsigned char)input << 4;
-  InputState curr = (InputState)(chopped >> 4);
-
-  std::vector<std::pair<BufferItem, int>> toAdd;
-  for (auto it = _prefixes.begin(); it != _prefixes.end();)
+  const uint8_t direction = static_cast<uint8_t>(input) & 0x0F;
+  _state.directions[_state.head] = direction;
+  _state.head = static_cast<uint8_t>((_state.head + 1) % _limit);
+  _state.completed = SpecialMoveDictionary::Root;
+
+  // every live prefix ages, and the ones this input extends hand their age down (children have higher node numbers
+  // than their parents, so extending in place would extend the new prefixes again)
+  const int nodes = _dictionary->Nodes();
+  int8_t aged[SpecialMoveDictionary::MaxNodes];
+  for (int node = 1; node < nodes; node++)
+    aged[node] = _last.ages[node] == NoAge || _last.ages[node] + 1 > _limit ? NoAge : static_cast<int8_t>(_last.ages[node] + 1);
+  std::copy(aged + 1, aged + nodes, _state.ages + 1);
+
+  for (int node = 1; node < nodes; node++)
   {
-    it->second++;
-    if (it->second > _limit)
-    {
-      it = _prefixes.erase(it);
+    if (aged[node] == NoAge)
       continue;
-    }
-
-    const std::list<InputState>& frontier = it->first.sequence;
 
-    // copy frontier and push our next state onto the end
-    std::list<InputState> searchInput = frontier;
-    searchInput.push_back(curr);
-    TrieReturnValue result = _dictionary.Search(searchInput);
+    const uint8_t next = _dictionary->Next(static_cast<uint8_t>(node), direction);
+    if (next == SpecialMoveDictionary::NoNode)
+      continue;
 
-    if (result == TrieReturnValue::Leaf)
-    {
-      _latestCompletedSequence = searchInput;
-    }
-    else if (result == TrieReturnValue::Branch)
+    // a completed motion isn't a prefix of a longer one, it is reported instead. When two complete on the same input
+    // (a quarter circle and a dash both ending forward), the one listed first in the dictionary has the lower node
+    if (_dictionary->Completes(next))
     {
-      toAdd.push_back(std::make_pair(BufferItem{ searchInput }, it->second));
+      if (_state.completed == SpecialMoveDictionary::Root || next < _state.completed)
+        _state.completed = next;
     }
-    it++;
+    else
+      _state.ages[next] = aged[node];
   }
 
-  // either insert new sequence or update existing age
-  _lastPrefixes = _prefixes;
-  for (auto& item : toAdd)
-  {
-    _prefixes[item.first] = item.second;
-  }
+  // and any motion can start on this input
+  const uint8_t first = _dictionary->Next(SpecialMoveDictionary::Root, direction);
+  if (first != SpecialMoveDictionary::NoNode && !_dictionary->Completes(first))
+    _state.ages[first] = 0;
 
-  std::list<InputState> list = { curr };
-  TrieReturnValue result = _dictionary.Search(list);
-  if (result == TrieReturnValue::Branch)
-  {
-    _prefixes[BufferItem{ list }] = 0;
-  }
-
-  if (_latestCompletedSequence.empty())
-    _latestInput = SpecialInputState::NONE;
-  else
-    _latestInput = _dictionary.GetKeyValue(_latestCompletedSequence);
+  _state.latestInput = _state.completed == SpecialMoveDictionary::Root ? SpecialInputState::NONE : _dictionary->Value(_state.completed);
 }
 
 //______________________________________________________________________________
 void InputSequenceBuffer::RollbackLastInput()
 {
-  _prefixes = _lastPrefixes;
+  _state = _last;
 }
 
 //______________________________________________________________________________
 const SpecialInputState& InputSequenceBuffer::GetLastSpecialInput() const
 {
-  return _latestInput;
+  return _state.latestInput;
 }
 
 //______________________________________________________________________________
 void InputSequenceBuffer::Clear()
 {
-  _latestCompletedSequence = {};
-  _prefixes.clear();
-  _latestInput = SpecialInputState::NONE;
+  Reset(_state);
+  _last = _state;
 }
 
 //______________________________________________________________________________
 void InputSequenceBuffer::Serialize(std::ostream& os) const
 {
-  // serialize the last input state
-  Serializer<SpecialInputState>::Serialize(os, _latestInput);
-
-  // serialize the last input sequence
-  Serializer<std::list<InputState>>::Serialize(os, _latestCompletedSequence);
-
-  Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Serialize(os, _prefixes);
-  Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Serialize(os, _lastPrefixes);
+  os.write(reinterpret_cast<const char*>(&_state), sizeof(State));
+  os.write(reinterpret_cast<const char*>(&_last), sizeof(State));
 }
+
 //______________________________________________________________________________
 void InputSequenceBuffer::Deserialize(std::istream& is)
 {
-  Serializer<SpecialInputState>::Deserialize(is, _latestInput);
-  Serializer<std::list<InputState>>::Deserialize(is, _latestCompletedSequence);
-  Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Deserialize(is, _prefixes);
-  Serializer<std::unordered_map<BufferItem, int, BufferItem>>::Deserialize(is, _lastPrefixes);
+  is.read(reinterpret_cast<char*>(&_state), sizeof(State));
+  is.read(reinterpret_cast<char*>(&_last), sizeof(State));
+}
+
+//______________________________________________________________________________
+std::string InputSequenceBuffer::Log()
+{
+  // a node's sequence is the directions taken from the root to it
+  auto sequence = [this](uint8_t node)
+  {
+    std::string s;
+    for (; node != SpecialMoveDictionary::Root; node = _dictionary->Parent(node))
+      s.insert(0, " " + std::to_string(_dictionary->Direction(node)));
+    return "{" + s + " }";
+  };
+
+  std::stringstream ss;
+  ss << "InputSequenceBuffer\n";
+  ss << "\tLast completed sequence: " << (_state.completed == SpecialMoveDictionary::Root ? "{ }" : sequence(_state.completed));
+  ss << "\tCurrent prefixes: ";
+  for (int node = 1; node < _dictionary->Nodes(); node++)
+  {
+    if (_state.ages[node] != NoAge)
+      ss << sequence(static_cast<uint8_t>(node)) << " : " << static_cast<int>(_state.ages[node]);
+  }
+  ss << "\n\tLast directions:";
+  for (int i = 0; i < _limit; i++)
+    ss << " " << static_cast<int>(_state.directions[(_state.head + i) % _limit]);
+  ss << "\n";
+  return ss.str();
 }
@@ -1,109 +1,100 @@
 #pragma once
-#include "Core/Utility/TrieNode.h"
 #include "Core/InputState.h"
 #include "Core/Interfaces/Serializable.h"
 
-template <> struct Serializer<std::list<InputState>>
-{
-  static void Serialize(std::ostream& os, const std::list<InputState>& item);
-  static void Deserialize(std::istream& is, std::list<InputState>& item);
-};
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <utility>
 
-struct BufferItem
+//______________________________________________________________________________
+//! Special move motions as a trie laid out in a flat array. Each node is a prefix of one or more motions and has one
+//! child per direction (the bottom 4 bits of an InputState), so following a motion one input at a time is one lookup
+class SpecialMoveDictionary
 {
-  //!
-  std::list<InputState> sequence;
-  //!
-  friend bool operator==(const BufferItem& k1, const BufferItem& k2)
-  {
-    if (k1.sequence.size() != k2.sequence.size())
-      return false;
-    return std::equal(k1.sequence.begin(), k1.sequence.end(), k2.sequence.begin(), [](InputState a, InputState b) { return a == b; });
-
-    /*auto it2 = k2.sequence.begin();
-    for (auto it1 = k1.sequence.begin(); it1 != k1.sequence.end() && it2 != k2.sequence.end(); ++it1, ++it2)
-    {
-      if (*it1 != *it2)
-        return false;
-    }
-    return true;*/
-  }
-  //! hasher
-  std::size_t operator()(BufferItem item) const;
-  //!
-  operator std::string() const
-  {
-    std::string s = "{";
-    for (const auto& item : sequence)
-      s += (" " + std::to_string((int)item));
-    s += " }";
-    return s;
-  }
+public:
+  //! Most nodes (prefixes of all the motions, plus the root)
+  static constexpr int MaxNodes = 64;
+  static constexpr int Directions = 16;
+  static constexpr uint8_t Root = 0;
+  //! Child of a node that isn't a prefix of any motion (the root is nobody's child)
+  static constexpr uint8_t NoNode = 0;
+
+  SpecialMoveDictionary(std::initializer_list<std::pair<std::list<InputState>, SpecialInputState>> motions);
+
+  //! Node reached by following direction from node, NoNode if no motion goes that way
+  uint8_t Next(uint8_t node, uint8_t direction) const { return _nodes[node].next[direction]; }
+  //! Whether a motion ends on the node
+  bool Completes(uint8_t node) const { return _nodes[node].completes; }
+  SpecialInputState Value(uint8_t node) const { return _nodes[node].value; }
+  //! Node the node was reached from and the direction taken
+  uint8_t Parent(uint8_t node) const { return _nodes[node].parent; }
+  uint8_t Direction(uint8_t node) const { return _nodes[node].direction; }
+  int Nodes() const { return _count; }
 
-};
+private:
+  struct Node
+  {
+    uint8_t next[Directions];
+    uint8_t parent;
+    uint8_t direction;
+    bool completes;
+    SpecialInputState value;
+  };
 
-bool operator<(const BufferItem& lhs, const BufferItem& rhs);
+  Node _nodes[MaxNodes] = {};
+  int _count = 1;
 
-template <> struct Serializer<std::unordered_map<BufferItem, int, BufferItem>>
-{
-  static void Serialize(std::ostream& os, const std::unordered_map<BufferItem, int, BufferItem>& item);
-  static void Deserialize(std::istream& is, std::unordered_map<BufferItem, int, BufferItem>& item);
 };
 
+//______________________________________________________________________________
+//! Detects special move motions in the stream of inputs. Every prefix of a motion that was entered in the last limit
+//! inputs is live, and keeps the age of its first input. A live prefix can wait on its next direction for as long as it
+//! stays live, so a held direction doesn't break a motion. Live prefixes are kept by dictionary node in a flat array
+//! and the last directions in a ring, so pushing an input and snapshotting the buffer don't allocate
 class InputSequenceBuffer : ISerializable
 {
 public:
-  InputSequenceBuffer(int limit, const TrieNode<InputState, SpecialInputState>& dict) : _limit(limit), _dictionary(dict) {}
+  //! Most inputs a motion can take to enter
+  static constexpr int MaxLimit = 64;
 
-  void PushInput(const InputState& input);
+  InputSequenceBuffer(int limit, const SpecialMoveDictionary& dict);
 
+  void PushInput(const InputState& input);
+  //! Undoes the last PushInput, so it can be pushed again with another input
   void RollbackLastInput();
 
   SpecialInputState const& GetLastSpecialInput() const;
 
   void Clear();
 
+  //! The state is plain data, written and read as it is
   void Serialize(std::ostream& os) const override;
   void Deserialize(std::istream& is) override;
-  std::string Log() override
-  {
-    std::stringstream ss;
-    ss << "InputSequenceBuffer\n";
-
-    std::string s = "{";
-    for (const auto& item : _latestCompletedSequence)
-      s += (" " + std::to_string((int)item));
-    s += " }";
-
-    ss << "\tLast completed sequence: " << s;
-    ss << "\tCurrent prefixes: ";
-    for (auto pair : _prefixes)
-    {
-      std::string strang = pair.first;
-      strang += (" : " + std::to_string(pair.second));
-      ss << strang;
-    }
-    ss << "\n\tLast prefixes: ";
-    for (auto pair : _lastPrefixes)
-    {
-      std::string strang = pair.first;
-      strang += (" : " + std::to_string(pair.second));
-      ss << strang;
-    }
-    ss << "\n";
-    return ss.str();
-  }
+  std::string Log() override;
 
 private:
-  TrieNode<InputState, SpecialInputState> _dictionary;
-  //std::vector<std::pair<int, std::list<InputState>>> _prefixes;
-  std::unordered_map<BufferItem, int, BufferItem> _prefixes;
-
-  //! copy of prefix map for roll back events
-  std::unordered_map<BufferItem, int, BufferItem> _lastPrefixes;
+  //! Not live
+  static constexpr int8_t NoAge = -1;
 
-  SpecialInputState _latestInput = SpecialInputState::NONE;
-  std::list<InputState> _latestCompletedSequence = {};
+  struct State
+  {
+    //! Age of the live prefix ending on each dictionary node, NoAge if it isn't live
+    int8_t ages[SpecialMoveDictionary::MaxNodes];
+    //! Last directions pushed, the next one goes at head
+    uint8_t directions[MaxLimit];
+    uint8_t head;
+    //! Node the last completed motion ended on, Root if the last input didn't complete one
+    uint8_t completed;
+    SpecialInputState latestInput;
+  };
+
+  void Reset(State& state) const;
+
+  const SpecialMoveDictionary* _dictionary;
+  State _state;
+  //! State before the last PushInput
+  State _last;
 
   int _limit;
 };
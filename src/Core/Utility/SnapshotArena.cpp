@@ -0,0 +1,99 @@
+#include "Core/Utility/SnapshotArena.h"
+
+#include <algorithm>
+#include <cstring>
+
+//______________________________________________________________________________
+ArenaWriteBuffer::ArenaWriteBuffer(size_t initialCapacity) : _data(new char[std::max<size_t>(initialCapacity, 1)]), _capacity(std::max<size_t>(initialCapacity, 1))
+{
+  Reset();
+}
+
+//______________________________________________________________________________
+ArenaWriteBuffer::int_type ArenaWriteBuffer::overflow(int_type ch)
+{
+  if (traits_type::eq_int_type(ch, traits_type::eof()))
+    return traits_type::not_eof(ch);
+
+  Grow(_capacity + 1);
+  *pptr() = traits_type::to_char_type(ch);
+  pbump(1);
+  return ch;
+}
+
+//______________________________________________________________________________
+std::streamsize ArenaWriteBuffer::xsputn(const char* s, std::streamsize n)
+{
+  const size_t count = static_cast<size_t>(n);
+  if (static_cast<size_t>(epptr() - pptr()) < count)
+    Grow(Size() + count);
+
+  std::memcpy(pptr(), s, count);
+  pbump(static_cast<int>(count));
+  return n;
+}
+
+//______________________________________________________________________________
+char* ArenaWriteBuffer::Claim(size_t count)
+{
+  if (static_cast<size_t>(epptr() - pptr()) < count)
+    Grow(Size() + count);
+
+  char* start = pptr();
+  pbump(static_cast<int>(count));
+  return start;
+}
+
+//______________________________________________________________________________
+ArenaWriteBuffer::pos_type ArenaWriteBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+  if (off != 0 || dir != std::ios_base::cur || !(which & std::ios_base::out))
+    return pos_type(off_type(-1));
+  return pos_type(static_cast<off_type>(Size()));
+}
+
+//______________________________________________________________________________
+void ArenaWriteBuffer::Grow(size_t minCapacity)
+{
+  const size_t size = Size();
+  const size_t capacity = std::max(_capacity * 2, minCapacity);
+
+  std::unique_ptr<char[]> data(new char[capacity]);
+  std::memcpy(data.get(), _data.get(), size);
+  _data = std::move(data);
+  _capacity = capacity;
+
+  setp(_data.get(), _data.get() + _capacity);
+  pbump(static_cast<int>(size));
+}
+
+//______________________________________________________________________________
+void ArenaReadBuffer::Reset(const char* data, size_t size)
+{
+  // the get area is never written through, streambuf just doesn't have a const interface
+  char* begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+}
+
+//______________________________________________________________________________
+const char* ArenaReadBuffer::Consume(size_t count)
+{
+  if (Remaining() < count)
+    return nullptr;
+
+  const char* start = gptr();
+  gbump(static_cast<int>(count));
+  return start;
+}
+
+//______________________________________________________________________________
+std::streamsize ArenaReadBuffer::xsgetn(char* s, std::streamsize n)
+{
+  const size_t count = std::min(static_cast<size_t>(n), Remaining());
+  if (count > 0)
+  {
+    std::memcpy(s, gptr(), count);
+    gbump(static_cast<int>(count));
+  }
+  return static_cast<std::streamsize>(count);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+
+//______________________________________________________________________________
+//! Reusable byte arena written through a bump cursor. Memory is kept between snapshots and only grows (doubling) when
+//! a snapshot doesn't fit, so steady state saving never allocates
+class ArenaWriteBuffer : public std::streambuf
+{
+public:
+  explicit ArenaWriteBuffer(size_t initialCapacity);
+
+  //! Moves the cursor back to the start, keeping the memory
+  void Reset() { setp(_data.get(), _data.get() + _capacity); }
+  //! Start of the written bytes
+  const char* Data() const { return pbase(); }
+  //! Number of bytes written since the last reset
+  size_t Size() const { return static_cast<size_t>(pptr() - pbase()); }
+  //! Moves the cursor past count bytes and returns where they start, so they can be filled in place
+  char* Claim(size_t count);
+
+protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+  //! Only reports the write position (tellp), the cursor can't be moved
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+
+private:
+  //! Reallocates to at least minCapacity, keeping the written bytes
+  void Grow(size_t minCapacity);
+
+  std::unique_ptr<char[]> _data;
+  size_t _capacity = 0;
+
+};
+
+//______________________________________________________________________________
+//! Reads a snapshot in place (no copy). Reads past the end are clamped, which sets eof/fail on the stream like
+//! running out of a stringstream does
+class ArenaReadBuffer : public std::streambuf
+{
+public:
+  //! Points the cursor at the start of the bytes
+  void Reset(const char* data, size_t size);
+  //! Bytes left to read
+  size_t Remaining() const { return static_cast<size_t>(egptr() - gptr()); }
+  //! Moves the cursor past count bytes and returns where they start, nullptr (without moving) if there aren't that many
+  const char* Consume(size_t count);
+
+protected:
+  std::streamsize xsgetn(char* s, std::streamsize n) override;
+
+};
+
+//______________________________________________________________________________
+//! Owns a write arena and the stream component Serialize functions write through
+class SnapshotWriter
+{
+public:
+  explicit SnapshotWriter(size_t initialCapacity = 16 * 1024) : _buffer(initialCapacity), _stream(&_buffer) {}
+
+  //! Starts a new snapshot at the beginning of the arena
+  std::ostream& Begin() { _buffer.Reset(); _stream.clear(); return _stream; }
+  //! Written bytes, valid until the next Begin
+  const char* Data() const { return _buffer.Data(); }
+  size_t Size() const { return _buffer.Size(); }
+  //! Reserves count bytes at the end of the snapshot to be written directly, without going through the stream
+  char* Claim(size_t count) { return _buffer.Claim(count); }
+
+private:
+  ArenaWriteBuffer _buffer;
+  std::ostream _stream;
+
+};
+
+//______________________________________________________________________________
+//! Stream over a snapshot in memory for component Deserialize functions
+class SnapshotReader
+{
+public:
+  SnapshotReader() : _stream(&_buffer) {}
+
+  //! Starts reading the bytes from the beginning. They have to outlive the reads
+  std::istream& Begin(const char* data, size_t size) { _buffer.Reset(data, size); _stream.clear(); return _stream; }
+  //! Bytes left to read
+  size_t Remaining() const { return _buffer.Remaining(); }
+  //! Reads count bytes in place, without going through the stream. nullptr if the snapshot is shorter than that
+  const char* Consume(size_t count) { return _buffer.Consume(count); }
+
+private:
+  ArenaReadBuffer _buffer;
+  std::istream _stream;
+
+};
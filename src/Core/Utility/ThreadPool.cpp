@@ -0,0 +1,103 @@
+#include "Core/Utility/ThreadPool.h"
+
+#include <algorithm>
+
+thread_local size_t ThreadPool::_threadQueue = static_cast<size_t>(-1);
+
+//______________________________________________________________________________
+ThreadPool::ThreadPool()
+{
+  // leave a core for the main thread, which helps while it waits anyway
+  const size_t hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  const size_t nWorkers = std::min<size_t>(hardwareThreads - 1, 4);
+
+  for (size_t i = 0; i < nWorkers + 1; i++)
+    _queues.push_back(std::make_unique<WorkQueue>());
+
+  for (size_t i = 0; i < nWorkers; i++)
+    _workers.emplace_back([this, i]() { WorkerLoop(i); });
+}
+
+//______________________________________________________________________________
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lock(_wakeMutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+
+  for (std::thread& worker : _workers)
+    worker.join();
+}
+
+//______________________________________________________________________________
+void ThreadPool::Submit(const Task& task)
+{
+  const size_t queueIndex = _threadQueue < _queues.size() ? _threadQueue : _queues.size() - 1;
+  // count the task before publishing it, a worker can pop it (and count it off) as soon as it's in the queue
+  {
+    std::lock_guard lock(_wakeMutex);
+    _queuedTasks++;
+  }
+  {
+    std::lock_guard lock(_queues[queueIndex]->mutex);
+    _queues[queueIndex]->tasks.push_back(task);
+  }
+  _wake.notify_one();
+}
+
+//______________________________________________________________________________
+void ThreadPool::WorkerLoop(size_t queueIndex)
+{
+  _threadQueue = queueIndex;
+  while (true)
+  {
+    if (RunOne(queueIndex))
+      continue;
+
+    std::unique_lock lock(_wakeMutex);
+    _wake.wait(lock, [this]() { return _stopping || _queuedTasks > 0; });
+    if (_stopping)
+      return;
+  }
+}
+
+//______________________________________________________________________________
+bool ThreadPool::RunOne(size_t queueIndex)
+{
+  Task task;
+  bool found = false;
+
+  // own work first, newest task (most likely to be warm in cache)
+  {
+    WorkQueue& own = *_queues[queueIndex];
+    std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty())
+    {
+      task = own.tasks.back();
+      own.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // then steal the oldest task of another queue
+  for (size_t offset = 1; !found && offset < _queues.size(); offset++)
+  {
+    WorkQueue& victim = *_queues[(queueIndex + offset) % _queues.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty())
+    {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if (!found)
+    return false;
+
+  _queuedTasks--;
+  task.fn(task.context, task.index);
+  return true;
+}
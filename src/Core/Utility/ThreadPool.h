@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//______________________________________________________________________________
+//! Small work-stealing pool. Each worker owns a deque: it pushes and pops its own tasks at the back and steals from the
+//! front of the others when it runs dry. Tasks are plain function pointers with a context so submitting never allocates
+class ThreadPool
+{
+public:
+  struct Task
+  {
+    void (*fn)(void* context, uint32_t index);
+    void* context;
+    uint32_t index;
+  };
+
+  //! Static getter
+  static ThreadPool& Get()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  //! Number of worker threads (the thread calling HelpUntil also runs tasks)
+  size_t NumWorkers() const { return _workers.size(); }
+  //! Queues a task. From a worker it goes on that worker's own deque, otherwise on the external deque
+  void Submit(const Task& task);
+  //! Runs and steals tasks on the calling thread until done() returns true
+  template <typename Fn>
+  void HelpUntil(Fn&& done);
+
+private:
+  ThreadPool();
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool operator=(const ThreadPool&) = delete;
+  ThreadPool operator=(ThreadPool&&) = delete;
+
+  struct WorkQueue
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  //! Main loop of each worker
+  void WorkerLoop(size_t queueIndex);
+  //! Pops from the back of own queue or steals from the front of another. Returns false if there was nothing to run
+  bool RunOne(size_t queueIndex);
+
+  //! One queue per worker plus the last one for threads outside the pool
+  std::vector<std::unique_ptr<WorkQueue>> _queues;
+  std::vector<std::thread> _workers;
+
+  //! Number of tasks submitted but not yet taken
+  std::atomic<uint32_t> _queuedTasks = 0;
+  std::atomic<bool> _stopping = false;
+  std::mutex _wakeMutex;
+  std::condition_variable _wake;
+
+  //! Queue owned by the current thread
+  static thread_local size_t _threadQueue;
+
+};
+
+//______________________________________________________________________________
+template <typename Fn>
+inline void ThreadPool::HelpUntil(Fn&& done)
+{
+  const size_t external = _queues.size() - 1;
+  while (!done())
+  {
+    if (!RunOne(external))
+      std::this_thread::yield();
+  }
+}
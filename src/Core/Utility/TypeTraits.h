@@ -1,4 +1,7 @@
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
 
 template <typename T, typename... Rest>
 bool constexpr all_base_of()
@@ -12,3 +15,26 @@ inline void hash_combine(std::size_t& seed, const T& v)
   std::hash<T> hasher;
   seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
+
+//! Compile-time list of types
+template <typename... T>
+struct type_list
+{
+  static constexpr size_t size = sizeof...(T);
+};
+
+//! Index of T in the type list. Fails to compile if T is not in the list
+template <typename T, typename List>
+struct type_list_index;
+
+template <typename T, typename... Rest>
+struct type_list_index<T, type_list<T, Rest...>> : std::integral_constant<size_t, 0> {};
+
+template <typename T, typename U, typename... Rest>
+struct type_list_index<T, type_list<U, Rest...>> : std::integral_constant<size_t, 1 + type_list_index<T, type_list<Rest...>>::value> {};
+
+template <typename T>
+struct type_list_index<T, type_list<>>
+{
+  static_assert(!std::is_same_v<T, T>, "Type is not a member of the type list");
+};
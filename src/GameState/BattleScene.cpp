@@ -1,5 +1,6 @@
 #include "GameState/BattleScene.h"
 #include "Managers/GameManagement.h"
+#include "Core/ECS/SystemScheduler.h"
 
 #include "Components/Camera.h"
 #include "Components/Animator.h"
@@ -55,96 +56,109 @@ IScene* SceneHelper::CreateScene(SceneType type)
   }
 }
 
-BattleScene::~BattleScene()
-{
-  //for (int i = 0; i < _uiEntities.size(); i++)
-  //  GameManager::Get().DestroyEntity(_uiEntities[i]);
-
-  GameManager::Get().DestroyEntity(_p1UIAnchor);
-  GameManager::Get().DestroyEntity(_p2UIAnchor);
-
-  // we are moving into the after match cutscene, so only remove game state related components
-  _p1->RemoveComponents<GameActor, StateComponent, Hurtbox, UIContainer, WallPushComponent, TimerContainer>();
-  _p2->RemoveComponents<GameActor, StateComponent, Hurtbox, UIContainer, WallPushComponent, TimerContainer>();
-}
-
-void BattleScene::Init(std::shared_ptr<Entity> p1, std::shared_ptr<Entity> p2)
-{
-  _p1 = p1;
-  _p2 = p2;
-
-  InitCharacter(Vector2<int>(100, 0), _p1, true);
-  InitCharacter(Vector2<int>(400, 0), _p2, false);
-
-  //set player state to neutral
-  ActionFactory::GoToNeutralAction(_p1->GetID(), _p1->GetComponent<StateComponent>());
-  ActionFactory::GoToNeutralAction(_p2->GetID(), _p2->GetComponent<StateComponent>());
-  _p1->AddComponent<InputListenerComponent>();
-  _p2->AddComponent<InputListenerComponent>();
-}
-
-void BattleScene::Update(float deltaTime)
+BattleScene::BattleScene(MatchMetaComponent& matchData) : ISubScene(matchData)
 {
   // transition entities to neutral before enacting
-  TransitionToNeutralSystem::DoTick(deltaTime);
+  _systems.Add<TransitionToNeutralSystem>();
 
   // check the hitboxes potentially just created
-  HitSystem::DoTick(deltaTime);
-  ThrowSystem::DoTick(deltaTime);
-  WallPushSystem::DoTick(deltaTime);
+  _systems.Add<HitSystem>();
+  _systems.Add<ThrowSystem>();
+  _systems.Add<WallPushSystem>();
 
   // update player side system here cause it forces new state
-  PlayerSideSystem::DoTick(deltaTime);
+  _systems.Add<PlayerSideSystem>();
 
   // update ui based on state right before inputs are collected
-  UIPositionUpdateSystem::DoTick(deltaTime);
-  UIContainerUpdateSystem::DoTick(deltaTime);
+  _systems.Add<UIPositionUpdateSystem>();
+  _systems.Add<UIContainerUpdateSystem>();
 
   // update based on state at start of frame
-  UpdateAISystem::DoTick(deltaTime);
+  _systems.Add<UpdateAISystem>();
 
   ////++++ state machine section ++++////
-  InputSystem::DoTick(deltaTime);
+  _systems.Add<InputSystem>();
 
   // Check action state machine after all game context gets updated
-  StateTransitionAggregate::DoTick(deltaTime);
-  HandleUpdateAggregate::DoTick(deltaTime);
+  _systems.AddExclusive(&StateTransitionAggregate::DoTick);
+  _systems.AddExclusive(&HandleUpdateAggregate::DoTick);
 
   // Enact new action states then clean them up
-  EnactAggregate::DoTick(deltaTime);
-  if(deltaTime > 0)
-    CleanUpActionSystem::PostUpdate();
+  _systems.AddExclusive(&EnactAggregate::DoTick);
+  _systems.AddExclusive([](float dt)
+  {
+    if (dt > 0)
+      CleanUpActionSystem::PostUpdate();
+  });
   ////++++ end state machine section ++++///
-  
+
   // update timer systems after state has been chosen
-  TimedActionSystem::DoTick(deltaTime);
+  _systems.Add<TimedActionSystem>();
 
   // update animation listener
-  AnimationListenerSystem::DoTick(deltaTime);
-  AnimationSystem::DoTick(deltaTime);
+  _systems.Add<AnimationListenerSystem>();
+  _systems.Add<AnimationSystem>();
   // advance attack event schedules before checking hitboxes
-  AttackAnimationSystem::DoTick(deltaTime);
+  _systems.Add<AttackAnimationSystem>();
 
   // resolve collisions
-  ApplyGravitySystem::DoTick(deltaTime);
-  PhysicsSystem::DoTick(deltaTime);
-  // update the location of the colliders
-  MoveSystem::DoTick(deltaTime);
+  _systems.Add<ApplyGravitySystem>();
+  _systems.Add<PhysicsSystem>();
+  // update the location of the colliders (the MoveSystem aggregate, split up so its parts can overlap)
+  _systems.Add<MoveSystemPhysCollider>();
+  _systems.Add<MoveSystemHurtbox>();
+  _systems.Add<MoveSystemHitbox>();
+  _systems.Add<MoveThrownEntitySystem>();
+  _systems.Add<CameraFollowPlayerSystem>();
+  _systems.Add<MoveSystemCamera>();
   // move walls according to camera position
-  MoveWallSystem::DoTick(deltaTime);
+  _systems.Add<MoveWallSystem>();
 
   ////++++ section for state dependent auxilliary info systems ++++////
 
-// do stuff that requires up to date actions
-  FrameAdvantageSystem::DoTick(deltaTime);
+  // do stuff that requires up to date actions
+  _systems.Add<FrameAdvantageSystem>();
 
   // update AI timers, UI timers (all non-state timers)
-  TimerSystem::DoTick(deltaTime);
+  _systems.Add<TimerSystem>();
 
   ////++++ end section for state dependent auxilliary info systems ++++////
 
   // check for battle complete and scene change
-  CheckBattleEndSystem::DoTick(deltaTime);
+  _systems.Add<CheckBattleEndSystem>();
+}
+
+BattleScene::~BattleScene()
+{
+  //for (int i = 0; i < _uiEntities.size(); i++)
+  //  GameManager::Get().DestroyEntity(_uiEntities[i]);
+
+  GameManager::Get().DestroyEntity(_p1UIAnchor);
+  GameManager::Get().DestroyEntity(_p2UIAnchor);
+
+  // we are moving into the after match cutscene, so only remove game state related components
+  _p1->RemoveComponents<GameActor, StateComponent, Hurtbox, UIContainer, WallPushComponent, TimerContainer>();
+  _p2->RemoveComponents<GameActor, StateComponent, Hurtbox, UIContainer, WallPushComponent, TimerContainer>();
+}
+
+void BattleScene::Init(std::shared_ptr<Entity> p1, std::shared_ptr<Entity> p2)
+{
+  _p1 = p1;
+  _p2 = p2;
+
+  InitCharacter(Vector2<int>(100, 0), _p1, true);
+  InitCharacter(Vector2<int>(400, 0), _p2, false);
+
+  //set player state to neutral
+  ActionFactory::GoToNeutralAction(_p1->GetID(), _p1->GetComponent<StateComponent>());
+  ActionFactory::GoToNeutralAction(_p2->GetID(), _p2->GetComponent<StateComponent>());
+  _p1->AddComponent<InputListenerComponent>();
+  _p2->AddComponent<InputListenerComponent>();
+}
+
+void BattleScene::Update(float deltaTime)
+{
+  _systems.Run(deltaTime);
 }
 
 BattleScene::StageBorders BattleScene::CreateStageBorders(const Rect<float>& stageRect, int screenWidth, int screenHeight)
@@ -1,10 +1,11 @@
 #pragma once
 #include "GameState/Scene.h"
+#include "Core/ECS/SystemScheduler.h"
 
 class BattleScene : public ISubScene
 {
 public:
-  BattleScene(MatchMetaComponent& matchData) : ISubScene(matchData) {}
+  BattleScene(MatchMetaComponent& matchData);
   virtual ~BattleScene();
   virtual void Init(std::shared_ptr<Entity> p1, std::shared_ptr<Entity> p2) final;
   virtual void Update(float deltaTime) final;
@@ -25,5 +26,8 @@ protected:
   // entities to be destroyed after this scene ends
   std::shared_ptr<Entity> _p1UIAnchor, _p2UIAnchor;
 
+  //! Systems ticked every frame, in this order unless their component access lets them overlap
+  SystemScheduler _systems;
+
 };
 
@@ -1,9 +1,6 @@
 // define all of the global static vars in this file
 #include "Globals.h"
 
-//______________________________________________________________________________
-int ECSGlobalStatus::NRegisteredComponents = 0;
-
 //______________________________________________________________________________
 int GlobalVars::HitStopFramesOnHit = 10;
 int GlobalVars::HitStopFramesOnBlock = 10;
@@ -17,6 +14,7 @@ bool GlobalVars::ShowHitEffects = true;
 //______________________________________________________________________________
 unsigned short NetGlobals::LocalUDPPort = 8001;
 int NetGlobals::FrameDelay = 2;
+int NetGlobals::MaxPredictionFrames = 8;
 
 //______________________________________________________________________________
 float Interpolation::Plateau::a = 2.0f;
@@ -1,7 +1,8 @@
 #pragma once
 #include "Core/Math/Vector2.h"
 
-const unsigned int MAX_ENTITIES = 500;
+//! Entity cap until changed with EntityManager::SetMaxEntities
+const unsigned int DEFAULT_MAX_ENTITIES = 500;
 const unsigned int MAX_COMPONENTS = 128;
 typedef unsigned int EntityID;
 
@@ -19,13 +20,6 @@ const int m_frameHeight = 112;
 const float m_characterWidth = 58.5f;
 const float m_characterHeight = 105.5f;
 
-struct ECSGlobalStatus
-{
-  //! Number of registered components
-  static int NRegisteredComponents;
-
-};
-
 //______________________________________________________________________________
 //! Editable global vars for gameplay mostly
 class GlobalVars
@@ -57,6 +51,8 @@ public:
   static unsigned short LocalUDPPort;
   //! defined based on the values found in https://github.com/pond3r/ggpo/blob/master/src/apps/vectorwar/vectorwar.h
   static int FrameDelay;
+  //! Number of frames the rollback can predict ahead (same as GGPO_MAX_PREDICTION_FRAMES)
+  static int MaxPredictionFrames;
 };
 
 //______________________________________________________________________________
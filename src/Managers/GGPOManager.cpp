@@ -5,30 +5,9 @@
 #include "Core/InputState.h"
 
 // for log function
+#include "Core/Utility/FastHash.h"
 #include <fstream>
 
-//______________________________________________________________________________
-int fletcher32_checksum(short* data, size_t len)
-{
-  int sum1 = 0xffff, sum2 = 0xffff;
-
-  while (len) {
-    size_t tlen = len > 360 ? 360 : len;
-    len -= tlen;
-    do {
-      sum1 += *data++;
-      sum2 += sum1;
-    } while (--tlen);
-    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
-    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
-  }
-
-  /* Second reduction step to reduce sums to 16 bits */
-  sum1 = (sum1 & 0xffff) + (sum1 >> 16);
-  sum2 = (sum2 & 0xffff) + (sum2 >> 16);
-  return sum2 << 16 | sum1;
-}
-
 //______________________________________________________________________________
 void GGPOManager::Player::SetConnectionState(ConnectionState nState)
 {
@@ -79,6 +58,9 @@ void GGPOManager::BeginSession(GGPOPlayer* players)
   if (_playingOnline)
     return;
 
+  // saved states live for max prediction frames, plus the confirmed frame and the one being saved
+  _snapshots.Allocate(static_cast<size_t>(NetGlobals::MaxPredictionFrames) + 2, SnapshotSlotCapacity);
+
   // start up win sockets which will get cleaned up on exit
   WSADATA wd = { 0 };
   WSAStartup(MAKEWORD(2, 2), &wd);
@@ -140,6 +122,7 @@ void GGPOManager::ExitSession()
     _playingOnline = false;
     ggpo_close_session(_session);
     _session = nullptr;
+    _snapshots.Release();
 
     WSACleanup();
   }
@@ -176,8 +159,8 @@ void GGPOManager::CallUpdate()
   // replace inputs with the synced inputs
   GameManager::Get().SyncPlayerInputs(inputs);
 
-  // move game forward by 1/60th of a second
-  GameManager::Get().Update(secPerFrame);
+  // GGPO only advances frames itself while rolling back, so these are never shown
+  GameManager::Get().Update(secPerFrame, SimulationPhase::Resimulate);
 }
 
 //______________________________________________________________________________
@@ -242,21 +225,15 @@ bool BeginGame(const char* game)
 //______________________________________________________________________________
 bool SaveGameState(unsigned char** buffer, int* len, int* checksum, int frame)
 {
-  SBuffer gamestate = GameManager::Get().CreateGameStateSnapshot();
-  size_t size = gamestate.size();
-
-  // set data length parameter
-  *len = static_cast<int>(size);
-
-  //copy the contents
-  *buffer = new unsigned char[size];
-  if (!*buffer)
-    return false;
-
-  memcpy_s(*buffer, size, gamestate.data(), size);
+  // serialize straight into the slot, ggpo keeps the pointer until it saves over this frame's slot
+  const SnapshotRing::Slot& slot = GGPOManager::Get().GetSnapshots().Save(frame, [frame](SnapshotWriter& writer, SnapshotIndex& index)
+  {
+    GameManager::Get().WriteRollbackSnapshot(frame, writer, index);
+  });
 
-  // using basic checksum from the ggpo example
-  *checksum = fletcher32_checksum((short*)*buffer, *len / 2);
+  *buffer = (unsigned char*)slot.writer.Data();
+  *len = static_cast<int>(slot.writer.Size());
+  *checksum = slot.checksum;
 
   return true;
 }
@@ -264,13 +241,8 @@ bool SaveGameState(unsigned char** buffer, int* len, int* checksum, int frame)
 //______________________________________________________________________________
 bool LoadGameState(unsigned char* buffer, int len)
 {
-  SBuffer gamestate;
-  size_t dataSize = static_cast<size_t>(len);
-  gamestate.resize(dataSize);
-
-  memcpy_s(gamestate.data(), dataSize, buffer, len);
-
-  GameManager::Get().LoadGamestateSnapshot(gamestate);
+  // read straight out of ggpo's buffer
+  GameManager::Get().LoadGamestateSnapshot(reinterpret_cast<const char*>(buffer), static_cast<size_t>(len));
 
   return true;
 }
@@ -280,70 +252,25 @@ bool LogGameState(char* filename, unsigned char* buffer, int len)
 {
   std::ofstream out(filename);
 
-  // write contents to the stream
-  std::stringstream stream;
-  stream.write((const char*)buffer, len);
-
-  // get the scene the snapshot was written in
-  SceneType snapshotScene;
-  Serializer<SceneType>::Deserialize(stream, snapshotScene);
-
-  out << "State in Scene: " << (int)snapshotScene << "\n";
-
-  bool frameStopActive;
-  int frameStop = 0;
-  Serializer<bool>::Deserialize(stream, frameStopActive);
-  Serializer<int>::Deserialize(stream, frameStop);
-
-  out << "Frame stop active: " << frameStopActive << " for " << frameStop << " frames\n";
-
-  while (!stream.eof())
+  // the buffer is one of the ring's slots, its index already says where every entity and component is. Listing the
+  // section hashes means the two logs of a desync can be diffed line by line to find the component
+  const SnapshotRing::Slot* slot = GGPOManager::Get().GetSnapshots().FindByData(reinterpret_cast<const char*>(buffer));
+  if (!slot)
   {
-    EntityID cpID = 0;
-    Serializer<EntityID>::Deserialize(stream, cpID);
-
-    if (stream.eof())
-      break;
-
-    std::cout << "Logging State for Entity :" << cpID << "\n";
-
-    std::shared_ptr<Entity> entity = GameManager::Get().CreateEntity<>();
-    entity->Deserialize(stream);
-
-    auto signature = entity->GetSignature();
-
-    std::cout << "Signature for entity: " << signature << "\n";
-    /*std::cout << "Checking signature attachments via signature test: \n";
-    
-    for (int i = 0; i < signature.size(); i++)
-    {
-      if (signature.test(i))
-      {
-        std::cout << "\t" << ECSCoordinator::Get().GetComponentName(i) << "\n";
-      }
-    }*/
-
-    std::cout << "Checking signature attachements via ECSGlobalStatus: \n";
-    for (size_t compIndex = 0; compIndex < ECSGlobalStatus::NRegisteredComponents; compIndex++)
-    {
-      if (signature.test(compIndex))
-      {
-        std::cout << "\t" << ECSCoordinator::Get().GetComponentName(compIndex) << "\n";
-      }
-    }
-
-    out << entity->Log();
-
-    GameManager::Get().DestroyEntity(entity->GetID());
+    out << "State of " << len << " bytes is not in the snapshot ring, hash " << std::hex << FastHash64(buffer, static_cast<size_t>(len)) << "\n";
+    return true;
   }
 
+  out << "State of frame " << slot->frame << ", " << len << " bytes, checksum " << std::hex << slot->checksum << std::dec << "\n";
+  GameManager::LogSnapshotSections(out, slot->index);
+
   return true;
 }
 
 //______________________________________________________________________________
 void FreeBuffer(void* buffer)
 {
-  delete[] buffer;
+  // owned by the snapshot ring
 }
 
 //______________________________________________________________________________
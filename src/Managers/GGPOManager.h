@@ -5,17 +5,10 @@
 #include <string_view>
 
 #include "Core/InputState.h"
+#include "Core/Rollback/SnapshotRing.h"
 
 #define NUM_PLAYERS 2
 
-/*
-* Simple checksum function stolen from wikipedia:
-*
-*   http://en.wikipedia.org/wiki/Fletcher%27s_checksum
-*/
-
-int fletcher32_checksum(short* data, size_t len);
-
 enum class ConnectionState
 {
   Connecting = 0,
@@ -75,6 +68,8 @@ public:
   bool InMatch() const { return _playingOnline; }
   //!
   GGPONetworkStats GetPlayerStats(int index);
+  //! Saved game states of the session, reused by frame number
+  SnapshotRing& GetSnapshots() { return _snapshots; }
 
 private:
 
@@ -94,6 +89,11 @@ private:
   int _localPlayerIndex = 0;
   int _remotePlayerIndex = 0;
 
+  //! Initial size of each saved state. Slots grow if a state doesn't fit, so this only has to be about right
+  static constexpr size_t SnapshotSlotCapacity = 64 * 1024;
+  //! Saved states handed to GGPO, allocated at session start
+  SnapshotRing _snapshots;
+
 };
 
 
@@ -107,6 +107,7 @@ static bool BeginGame(const char* game);
  * entire contents of the current game state into it, and copy the
  * length into the *len parameter.  Optionally, the client can compute
  * a checksum of the data and store it in the *checksum argument.
+ * (here the buffer is the frame's slot of the snapshot ring)
  */
 static bool SaveGameState(unsigned char** buffer, int* len, int* checksum, int frame);
 
@@ -129,6 +130,7 @@ static bool LogGameState(char* filename, unsigned char* buffer, int len);
 /*
  * free_buffer - Frees a game state allocated in save_game_state.  You
  * should deallocate the memory contained in the buffer.
+ * (nothing to do, ring slots are reused by frame number)
  */
 static void FreeBuffer(void* buffer);
 
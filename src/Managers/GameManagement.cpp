@@ -31,13 +31,20 @@
 
 #include "Components/Actors/GameActor.h"
 #include "Managers/GGPOManager.h"
+#include "Managers/RollbackManager.h"
+#include "Managers/ReplayManager.h"
+#include "Managers/SpectatorManager.h"
 
 #include "AssetManagement/EditableAssets/Editor/AnimationEditor.h"
 #include "AssetManagement/EditableAssets/AssetLibrary.h"
 
 #include "Core/Utility/Profiler.h"
+#include "Core/ECS/SystemScheduler.h"
+#include "Core/Utility/ThreadPool.h"
 
 #include <sstream>
+#include <chrono>
+#include <algorithm>
 
 #ifdef _DEBUG
 //used for debugger
@@ -114,7 +121,7 @@ void ResourceManager::CrawlTexture(Resource<SDL_Texture>& texture, Vector2<int>
 {
   auto& textureData = texture.GetInfo();
   // Get the window format
-  Uint32 windowFormat = SDL_GetWindowPixelFormat(GRenderer.GetWindow());
+  Uint32 windowFormat = GRenderer.GetWindowFormat();
   std::shared_ptr<SDL_PixelFormat> format = std::shared_ptr<SDL_PixelFormat>(SDL_AllocFormat(windowFormat), SDL_FreeFormat);
 
   // Get the pixel data
@@ -139,7 +146,7 @@ void ResourceManager::CrawlTexture(Resource<SDL_Texture>& texture, Vector2<int>
 //______________________________________________________________________________
 Rect<double> ResourceManager::FindRect(Resource<SDL_Texture>& texture, Vector2<int> frameSize, Vector2<int> begPx)
 {
-  Uint32 windowFormat = SDL_GetWindowPixelFormat(GRenderer.GetWindow());
+  Uint32 windowFormat = GRenderer.GetWindowFormat();
   std::shared_ptr<SDL_PixelFormat> format = std::shared_ptr<SDL_PixelFormat>(SDL_AllocFormat(windowFormat), SDL_FreeFormat);
 
   Uint32 transparent;
@@ -180,13 +187,24 @@ Rect<double> ResourceManager::FindRect(Resource<SDL_Texture>& texture, Vector2<i
 }
 
 //______________________________________________________________________________
-void GameManager::Initialize()
+void GameManager::Initialize(bool headless)
 {
-  GRenderer.Init();
+  if (headless)
+    GRenderer.InitHeadless();
+  else
+    GRenderer.Init();
 
   //! Call this to initialize animation collections and load them
   AnimationCollectionManager::Get();
 
+  //! timers refer to their callbacks by kind, so every kind is registered before anything can start one
+  TimerCallbacks::Get().Register(TimerCallbacks::HideOwner, [](EntityID owner)
+  {
+    if (Entity* entity = GameManager::Get().GetEntityByID(owner))
+      entity->RemoveComponent<RenderProperties>();
+  });
+  CutsceneAction::RegisterTimerCallbacks();
+
   //! initialize our player controllable entities
   _p1 = CreateEntity<GameInputComponent, Actor>();
   _p2 = CreateEntity<GameInputComponent, Actor>();
@@ -212,6 +230,7 @@ void GameManager::Destroy()
 
   _gameEntities.clear();
   _networkedEntities.clear();
+  _networkedSet.clear();
 }
 
 //______________________________________________________________________________
@@ -298,7 +317,15 @@ void GameManager::BeginGameLoop()
   GUIController::Get().AddImguiWindowFunction("Main Debug Window", "Scene Selection", sceneSelect);
 
   GUIController::Get().AddImguiWindowFunction("ECS Status", "Registered Components", []() {
-    ImGui::Text("Components = %d", ECSGlobalStatus::NRegisteredComponents);
+    ImGui::Text("Components = %d", static_cast<int>(NComponents));
+    ImGui::Text("Living entities = %d", static_cast<int>(EntityManager::Get().LivingEntityCount()));
+
+    int maxEntities = static_cast<int>(EntityManager::Get().GetMaxEntities());
+    if (ImGui::InputInt("Max entities", &maxEntities, 100) && maxEntities > 0)
+      EntityManager::Get().SetMaxEntities(static_cast<EntityID>(maxEntities));
+
+    ImGui::Checkbox("Parallel systems", &SystemScheduler::Parallel);
+    ImGui::Text("Worker threads = %d", static_cast<int>(ThreadPool::Get().NumWorkers()));
   });
 
 
@@ -437,6 +464,229 @@ void GameManager::BeginGameLoop()
     });
 #endif
 
+  GUIController::Get().AddImguiWindowFunction("Rollback", "Connect Player", [this]()
+  {
+    ImGui::BeginGroup();
+
+    if (!RollbackManager::Get().InMatch())
+    {
+      static int localUDPPort = static_cast<int>(NetGlobals::LocalUDPPort);
+      ImGui::InputInt("Local Port", &localUDPPort);
+      ImGui::InputInt("Frame Delay", &NetGlobals::FrameDelay);
+
+      static char ip[128] = "127.0.0.1";
+      ImGui::InputText("Remote Player Address", ip, 128);
+
+      static int port = 8002;
+      ImGui::InputInt("Connection Port", &port);
+
+      // packet shaping, applied to what this end sends
+      static NetworkConditions conditions;
+      static bool shapeUdp = false;
+      static int seed = 0;
+      static char logPath[256] = "rollbacks.csv";
+      static bool logRollbacks = false;
+      if (ImGui::CollapsingHeader("Network Conditions"))
+      {
+        ImGui::InputInt("Delay (ms)", &conditions.delayMs);
+        ImGui::InputInt("Jitter (ms)", &conditions.jitterMs);
+        ImGui::Combo("Jitter Shape", reinterpret_cast<int*>(&conditions.jitterShape), "Uniform\0Normal\0");
+        ImGui::SliderFloat("Loss", &conditions.loss, 0.0f, 1.0f);
+        ImGui::SliderFloat("Reorder", &conditions.reorder, 0.0f, 1.0f);
+        ImGui::InputInt("Reorder Hold (ms)", &conditions.reorderMs);
+        ImGui::InputInt("Seed", &seed);
+        ImGui::Checkbox("Apply To Connections", &shapeUdp);
+        ImGui::Checkbox("Log Rollbacks Per Second", &logRollbacks);
+        ImGui::InputText("Log File", logPath, sizeof(logPath));
+        conditions.seed = static_cast<uint32_t>(seed);
+      }
+      RollbackManager::Get().SetLogPath(logRollbacks ? logPath : "");
+
+      for (int position = 0; position < RollbackSession::NumPlayers; position++)
+      {
+        std::string label = "Connect On Position " + std::to_string(position + 1);
+        if (ImGui::Button(label.c_str()))
+        {
+          auto transport = std::make_unique<UdpTransport>(static_cast<unsigned short>(localUDPPort), ip, static_cast<unsigned short>(port));
+          if (transport->IsOpen())
+          {
+            if (shapeUdp)
+              BeginRollbackSession(position, std::make_unique<ConditionedTransport>(std::move(transport), conditions, &ConditionedTransport::SystemMilliseconds));
+            else
+              BeginRollbackSession(position, std::move(transport));
+          }
+        }
+      }
+
+      if (ImGui::Button("Play Simulated Remote"))
+        TriggerBeginningOfFrame([]() { RollbackManager::Get().BeginSimulatedSession(0, conditions); });
+
+      // the remote address and port are the host's spectator port
+      if (!SpectatorManager::Get().Spectating() && ImGui::Button("Spectate"))
+      {
+        auto transport = std::make_unique<UdpTransport>(static_cast<unsigned short>(localUDPPort), ip, static_cast<unsigned short>(port));
+        if (transport->IsOpen())
+          SpectatorManager::Get().BeginSpectating(std::move(transport));
+      }
+    }
+    else if (ImGui::Button("Disconnect"))
+    {
+      RollbackManager::Get().ExitSession();
+    }
+    ImGui::EndGroup();
+  });
+
+  GUIController::Get().AddImguiWindowFunction("Rollback", "Spectators", []()
+  {
+    SpectatorManager& spectators = SpectatorManager::Get();
+    if (const SpectatorSession* spectating = spectators.GetSpectatorSession())
+    {
+      if (!spectating->HasState())
+        ImGui::Text("Joining: %zu of %zu bytes of state", spectating->StateReceived(), spectating->StateSize());
+      else
+        ImGui::Text("Spectating frame %d, %d frames buffered", spectating->GetCurrentFrame(), spectating->FramesBuffered());
+      if (ImGui::Button("Stop Spectating"))
+        spectators.StopSpectating();
+      return;
+    }
+
+    // each spectator gets its own port on the host
+    static int hostPort = 8010;
+    static char spectatorAddress[128] = "127.0.0.1";
+    static int spectatorPort = 8020;
+    ImGui::InputInt("Host Port", &hostPort);
+    ImGui::InputText("Spectator Address", spectatorAddress, 128);
+    ImGui::InputInt("Spectator Port", &spectatorPort);
+    if (ImGui::Button("Add Spectator"))
+    {
+      auto transport = std::make_unique<UdpTransport>(static_cast<unsigned short>(hostPort), spectatorAddress, static_cast<unsigned short>(spectatorPort));
+      if (transport->IsOpen())
+      {
+        spectators.AddSpectator(std::move(transport));
+        hostPort++;
+        spectatorPort++;
+      }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Remove All"))
+      spectators.RemoveSpectators();
+
+    const SpectatorRelay& relay = spectators.GetRelay();
+    ImGui::Text("Join state: frame %d, %zu bytes, taken in %lld us", relay.StateFrame(), relay.StateSize(), relay.StateMicroseconds());
+    for (int i = 0; i < relay.Spectators(); i++)
+    {
+      const SpectatorRelay::Stats& stats = relay.GetStats(i);
+      const double frames = std::max(stats.frames, 1);
+      ImGui::Text("Spectator %d: frame %d, %.2f KB/s, %d packets, %.2f us per frame", i + 1, stats.lastFrame,
+        stats.bytesSent / frames * 60.0 / 1024.0, stats.packetsSent, stats.microseconds / frames);
+    }
+  });
+
+  GUIController::Get().AddImguiWindowFunction("Rollback", "Session Stats", []()
+  {
+    RollbackSession* session = RollbackManager::Get().GetSession();
+    if (!session)
+      return;
+
+    const RollbackSession::Stats& stats = session->GetStats();
+    ImGui::Text("Synchronized: %s", session->IsSynchronized() ? "yes" : "waiting for remote");
+    ImGui::Text("Frame: %d (confirmed %d)", session->GetCurrentFrame(), session->GetConfirmedFrame());
+    ImGui::Text("Rollbacks: %d, frames resimulated: %d (max depth %d)", stats.rollbacks, stats.framesResimulated, stats.maxRollbackFrames);
+    ImGui::Text("Last rollback: %d frames in %.3f ms", stats.lastRollbackFrames, stats.lastRollbackMicroseconds / 1000.0);
+    ImGui::Text("Average rollback: %.3f ms", stats.rollbacks ? stats.totalRollbackMicroseconds / 1000.0 / stats.rollbacks : 0.0);
+    ImGui::Text("Resimulated frame: %.3f ms average, %.3f ms in the last rollback",
+      stats.framesResimulated ? stats.totalResimulateMicroseconds / 1000.0 / stats.framesResimulated : 0.0,
+      stats.lastRollbackFrames ? stats.lastResimulateMicroseconds / 1000.0 / stats.lastRollbackFrames : 0.0);
+    ImGui::Text("Stalled frames: %d", stats.stalledFrames);
+  });
+
+  GUIController::Get().AddImguiWindowFunction("Replay", "Record and Play", [this]()
+  {
+    static char path[256] = "replay.fgr";
+    ReplayManager& replays = ReplayManager::Get();
+    Replay& replay = replays.GetReplay();
+
+    ImGui::BeginGroup();
+    if (!replays.Recording() && !replays.Playing())
+    {
+      if (ImGui::Button("Record"))
+        TriggerBeginningOfFrame([]() { ReplayManager::Get().StartRecording(); });
+      ImGui::SameLine();
+      if (ImGui::Button("Play") && replay.Keyframes() > 0)
+        TriggerBeginningOfFrame([]() { ReplayManager::Get().StartPlayback(); });
+    }
+    else if (replays.Recording())
+    {
+      ImGui::Text("Recording frame %d", replays.CurrentFrame());
+      if (ImGui::Button("Stop Recording"))
+        replays.StopRecording();
+    }
+    else
+    {
+      if (ImGui::Button(replays.Paused() ? "Resume" : "Pause"))
+        replays.SetPaused(!replays.Paused());
+      ImGui::SameLine();
+      if (ImGui::Button("Stop"))
+        replays.StopPlayback();
+
+      // seeks once the slider is let go of, each seek runs up to a keyframe interval of frames
+      static int seekFrame = 0;
+      static bool dragging = false;
+      if (!dragging)
+        seekFrame = replays.CurrentFrame();
+      ImGui::SliderInt("Frame", &seekFrame, 0, replay.Frames());
+      dragging = ImGui::IsItemActive();
+      if (ImGui::IsItemDeactivatedAfterEdit())
+      {
+        const int frame = seekFrame;
+        TriggerBeginningOfFrame([frame]() { ReplayManager::Get().Seek(frame); });
+      }
+      ImGui::Text("Last seek: %d frames in %.3f ms", replays.LastSeekFrames(), replays.LastSeekMicroseconds() / 1000.0);
+    }
+    ImGui::Text("%d frames, %d keyframes (%s vs %s)", replay.Frames(), replay.Keyframes(), replay.GetHeader().p1Character.c_str(), replay.GetHeader().p2Character.c_str());
+
+    ImGui::InputText("File", path, sizeof(path));
+    if (ImGui::Button("Save") && !replays.Recording())
+      replay.Save(path);
+    ImGui::SameLine();
+    if (ImGui::Button("Load") && !replays.Recording() && !replays.Playing())
+      replay.Load(path);
+    ImGui::EndGroup();
+  });
+
+  GUIController::Get().AddImguiWindowFunction("Replay", "Training Rewind", [this]()
+  {
+    ImGui::BeginGroup();
+    if (_rewind.Count() == 0)
+      ImGui::Text("Frames are kept while a training match is played");
+    else
+    {
+      // the slider loads as it is dragged, each kept frame is a full state so this is one load per change
+      int position = _rewindPosition == NoRewind ? _rewind.Count() - 1 : _rewindPosition;
+      if (ImGui::SliderInt("Frame", &position, 0, _rewind.Count() - 1))
+        TriggerBeginningOfFrame([this, position]() { RewindTo(position); });
+
+      if (ImGui::Button("<"))
+        TriggerBeginningOfFrame([this, position]() { RewindTo(position - 1); });
+      ImGui::SameLine();
+      if (ImGui::Button(">"))
+        TriggerBeginningOfFrame([this, position]() { RewindTo(position + 1); });
+      ImGui::SameLine();
+      if (_rewindPosition == NoRewind)
+      {
+        if (ImGui::Button("Hold"))
+          TriggerBeginningOfFrame([this]() { RewindTo(_rewind.Count() - 1); });
+      }
+      else if (ImGui::Button("Resume"))
+        TriggerBeginningOfFrame([this]() { ResumeFromRewind(); });
+
+      ImGui::Text("%d frames kept (%.1f s), %.2f of %.2f MB", _rewind.Count(), _rewind.Count() / 60.0f,
+        _rewind.BytesUsed() / (1024.0 * 1024.0), _rewind.Capacity() / (1024.0 * 1024.0));
+    }
+    ImGui::Text("Keeping a frame: %lld us, %lld us at most", _rewindLastMicroseconds, _rewindMaxMicroseconds);
+    ImGui::EndGroup();
+  });
+
   CharacterEditor::Get().AddCreateNewCharacterButton();
 
   GUIController::Get().AddImguiWindowFunction("Assets", "Sprite Sheets", []()
@@ -485,45 +735,6 @@ void GameManager::BeginGameLoop()
   GUIController::Get().CleanUp();
 }
 
-//______________________________________________________________________________
-void GameManager::CheckAgainstSystems(Entity* entity)
-{
-  InputSystem::Check(entity);
-  ApplyGravitySystem::Check(entity);
-  PhysicsSystem::Check(entity);
-  AnimationSystem::Check(entity);
-  MoveWallSystem::Check(entity);
-  AttackAnimationSystem::Check(entity);
-  HitSystem::Check(entity);
-  TimerSystem::Check(entity);
-  FrameAdvantageSystem::Check(entity);
-  SpriteDrawCallSystem::Check(entity);
-  UITextDrawCallSystem::Check(entity);
-  PlayerSideSystem::Check(entity);
-  CutsceneSystem::Check(entity);
-  CutsceneMovementSystem::Check(entity);
-  CheckBattleEndSystem::Check(entity);
-  UIPositionUpdateSystem::Check(entity);
-  UIContainerUpdateSystem::Check(entity);
-  DrawUIPrimitivesSystem::Check(entity);
-  UpdateAISystem::Check(entity);
-  ThrowSystem::Check(entity);
-  WallPushSystem::Check(entity);
-  DestroyEntitiesSystem::Check(entity);
-  MenuInputSystem::Check(entity);
-  UpdateMenuStateSystem::Check(entity);
-
-  AnimationListenerSystem::Check(entity);
-
-  // start moving stuff to aggregate systems like this
-  StateTransitionAggregate::Check(entity);
-  HandleUpdateAggregate::Check(entity);
-  EnactAggregate::Check(entity);
-
-  // another aggregate system
-  MoveSystem::Check(entity);
-}
-
 //______________________________________________________________________________
 void GameManager::ActivateHitStop(int frames)
 {
@@ -548,18 +759,18 @@ void GameManager::DestroyEntity(std::shared_ptr<Entity> entity)
 
 void GameManager::DestroyEntity(const EntityID& entity)
 {
-  auto it = _gameEntities.find(entity);
-  if (it != _gameEntities.end())
+  if (entity < _gameEntities.size() && _gameEntities[entity])
   {
     // delete from networked entities list 
     auto nIt = std::find(_networkedEntities.begin(), _networkedEntities.end(), entity);
     if (nIt != _networkedEntities.end())
     {
       _networkedEntities.erase(nIt);
+      _networkedSet.erase(entity);
     }
 
-    it->second->RemoveAllComponents();
-    _gameEntities.erase(it);
+    _gameEntities[entity]->RemoveAllComponents();
+    _gameEntities[entity].reset();
   }
 }
 
@@ -581,9 +792,39 @@ void GameManager::AdvanceCurrentScene()
 }
 
 //______________________________________________________________________________
-SBuffer GameManager::CreateGameStateSnapshot() const
+void GameManager::WriteRollbackSnapshot(int frame, SnapshotWriter& writer, SnapshotIndex& index)
 {
-  std::stringstream stream;
+  const int keyframeFrame = frame - frame % KeyframeInterval;
+  SnapshotKeyframe& keyframe = _keyframes[(keyframeFrame / KeyframeInterval) % 2];
+
+  if (frame == keyframeFrame)
+  {
+    keyframe.Reset(frame);
+    WriteSnapshot(writer, &index, nullptr, false, &keyframe);
+
+    // from here on, a component that isn't touched still matches this keyframe
+    const ComponentBitFlag& bulk = ECSCoordinator::Get().TrivialSnapshotComponents();
+    for (size_t componentID = 0; componentID < NComponents; componentID++)
+    {
+      if (bulk.test(componentID))
+        ECSCoordinator::Get().ClearDirtyComponents(componentID);
+    }
+    _cleanSinceKeyframe = frame;
+    return;
+  }
+
+  // the keyframe is missing if the session didn't start on one, the snapshot is complete then
+  const bool hasKeyframe = keyframe.Frame() == keyframeFrame;
+  // after rolling back past the last keyframe the dirty flags are relative to a later one and can't be used
+  WriteSnapshot(writer, &index, hasKeyframe ? &keyframe : nullptr, hasKeyframe && _cleanSinceKeyframe == keyframeFrame, nullptr);
+}
+
+//______________________________________________________________________________
+void GameManager::WriteSnapshot(SnapshotWriter& writer, SnapshotIndex* index, const SnapshotKeyframe* keyframe, bool useDirty, SnapshotKeyframe* capture) const
+{
+  std::ostream& stream = writer.Begin();
+  if (index)
+    index->Mark(stream, SnapshotIndex::NoEntity, SnapshotIndex::Header);
 
   // maybe serialize some metadata here?
   Serializer<SceneType>::Serialize(stream, _currentSceneType);
@@ -592,33 +833,46 @@ SBuffer GameManager::CreateGameStateSnapshot() const
   Serializer<bool>::Serialize(stream, _frameStopActive);
   Serializer<int>::Serialize(stream, _frameStop);
 
-  /*for (auto entity : _gameEntities)
-  {
-    Serializer<EntityID>::Serialize(stream, entity.first);
-    entity.second->Serialize(stream);
-  }*/
+  // keyframe the plain data components are written against
+  Serializer<int>::Serialize(stream, keyframe ? keyframe->Frame() : SnapshotKeyframe::NoFrame);
 
+  // components that are plain data are left out of the entities and written an array at a time after them
+  const ComponentBitFlag& bulk = ECSCoordinator::Get().TrivialSnapshotComponents();
+  Serializer<int>::Serialize(stream, static_cast<int>(_networkedEntities.size()));
   for (const EntityID& id : _networkedEntities)
   {
+    if (index)
+      index->Mark(stream, id, SnapshotIndex::EntityHeader);
     Serializer<EntityID>::Serialize(stream, id);
-    _gameEntities.at(id)->Serialize(stream);
+    _gameEntities[id]->Serialize(stream, index, bulk);
   }
 
-  // right now, lets just copy the player entities
-
-
-  //Serializer<EntityID>::Serialize(stream, _p2->GetID());
-  //_p2->Serialize(stream);
+  for (size_t componentID = 0; componentID < NComponents; componentID++)
+  {
+    if (!bulk.test(componentID))
+      continue;
+    // the count and owners of the array are a game section, each run is marked as part of its owner
+    if (index)
+      index->Mark(stream, SnapshotIndex::NoEntity, static_cast<int>(componentID));
+
+    const size_t start = writer.Size();
+    ECSCoordinator::Get().SerializeComponentArray(componentID, writer, _networkedSet, keyframe, useDirty, index);
+    if (capture)
+      capture->AddArray(static_cast<int>(componentID), writer.Data() + start, writer.Size() - start);
+  }
+}
 
-  return SBuffer(std::istreambuf_iterator<char>(stream), {});
+//______________________________________________________________________________
+SBuffer GameManager::CreateGameStateSnapshot() const
+{
+  const SnapshotWriter& snapshot = WriteGameStateSnapshot();
+  return SBuffer(snapshot.Data(), snapshot.Data() + snapshot.Size());
 }
 
 //______________________________________________________________________________
-void GameManager::LoadGamestateSnapshot(const SBuffer& snapshot)
+void GameManager::LoadGamestateSnapshot(const char* data, size_t size)
 {
-  // write contents to the stream
-  std::stringstream stream;
-  stream.write((const char*)snapshot.data(), snapshot.size());
+  std::istream& stream = _snapshotReader.Begin(data, size);
 
   // get the scene the snapshot was written in
   SceneType snapshotScene;
@@ -628,8 +882,28 @@ void GameManager::LoadGamestateSnapshot(const SBuffer& snapshot)
   Serializer<bool>::Deserialize(stream, _frameStopActive);
   Serializer<int>::Deserialize(stream, _frameStop);
 
+  int keyframeFrame = SnapshotKeyframe::NoFrame;
+  Serializer<int>::Deserialize(stream, keyframeFrame);
+  const SnapshotKeyframe* keyframe = nullptr;
+  if (keyframeFrame != SnapshotKeyframe::NoFrame)
+  {
+    keyframe = &_keyframes[(keyframeFrame / KeyframeInterval) % 2];
+    if (keyframe->Frame() != keyframeFrame)
+    {
+      std::cerr << "Snapshot was written against keyframe " << keyframeFrame << " which is no longer kept, rolled back too far?\n";
+      assert(false && "Snapshot keyframe is gone");
+      keyframe = nullptr;
+    }
+  }
+
+  const ComponentBitFlag& bulk = ECSCoordinator::Get().TrivialSnapshotComponents();
+  EntityRemap recreated;
+
+  int nEntities = 0;
+  Serializer<int>::Deserialize(stream, nEntities);
+
   std::vector<EntityID> nonLoadedEntities = _networkedEntities;
-  while (!stream.eof())
+  for (int i = 0; i < nEntities && stream; i++)
   {
     EntityID cpID = 0;
     Serializer<EntityID>::Deserialize(stream, cpID);
@@ -641,21 +915,22 @@ void GameManager::LoadGamestateSnapshot(const SBuffer& snapshot)
 
     // if this has already been destroyed, create new entity because it could possibly be a fireball or something
     // but maybe it should still throw a warning
-    if (_gameEntities.find(cpID) == _gameEntities.end())
+    if (!GetEntityByID(cpID))
     {
       entity = CreateEntity<>();
       std::cerr << "Attempting to load gamestate with inaccessible entities. Be careful entities are not being copied.\n";
 
       // add to networked list... probably need to sync this
       AddToNetworkedList(entity->GetID());
+      recreated.emplace_back(cpID, entity->GetID());
     }
     else
     {
-      entity = _gameEntities[cpID];
+      entity = ShareEntity(cpID);
     }
 
     // finally load the entire component state into the entity
-    entity->Deserialize(stream);
+    entity->Deserialize(stream, bulk);
 
     // remove from list of entities
     auto it = std::find(nonLoadedEntities.begin(), nonLoadedEntities.end(), cpID);
@@ -665,6 +940,22 @@ void GameManager::LoadGamestateSnapshot(const SBuffer& snapshot)
 
   for (const EntityID& id : nonLoadedEntities)
     DestroyEntity(id);
+
+  // the entities have all their components again, fill in the ones written an array at a time. A snapshot written
+  // against a keyframe only has the components that changed, the rest are the keyframe's
+  for (size_t componentID = 0; componentID < NComponents; componentID++)
+  {
+    if (!bulk.test(componentID))
+      continue;
+
+    const std::vector<char>* keyframeArray = keyframe ? keyframe->FindArray(static_cast<int>(componentID)) : nullptr;
+    if (keyframeArray)
+    {
+      _keyframeReader.Begin(keyframeArray->data(), keyframeArray->size());
+      ECSCoordinator::Get().DeserializeComponentArray(componentID, _keyframeReader, recreated);
+    }
+    ECSCoordinator::Get().DeserializeComponentArray(componentID, _snapshotReader, recreated);
+  }
 }
 
 //______________________________________________________________________________
@@ -673,18 +964,70 @@ std::string GameManager::LogGamestate()
   std::string s = "";
   for (const EntityID& id : _networkedEntities)
   {
-    s += _gameEntities.at(id)->Log();
+    s += _gameEntities[id]->Log();
   }
   return s;
 }
 
 //______________________________________________________________________________
-void GameManager::Update(float deltaTime)
+static std::string_view SnapshotPartName(int part)
+{
+  if (part == SnapshotIndex::Header)
+    return "Header";
+  if (part == SnapshotIndex::EntityHeader)
+    return "Signature";
+  return ECSCoordinator::Get().GetComponentName(static_cast<size_t>(part));
+}
+
+//______________________________________________________________________________
+void GameManager::LogSnapshotMismatches(std::ostream& os, const std::vector<SnapshotIndex::Mismatch>& mismatches)
+{
+  for (const SnapshotIndex::Mismatch& mismatch : mismatches)
+  {
+    if (mismatch.entity == SnapshotIndex::NoEntity)
+      os << "  game ";
+    else
+      os << "  entity " << mismatch.entity << " ";
+    os << SnapshotPartName(mismatch.part);
+
+    if (mismatch.type == SnapshotIndex::Mismatch::Type::Missing)
+      os << ": missing (" << mismatch.expectedSize << " bytes expected)\n";
+    else if (mismatch.type == SnapshotIndex::Mismatch::Type::Extra)
+      os << ": not expected (" << mismatch.actualSize << " bytes)\n";
+    else
+    {
+      os << ": differs at byte " << mismatch.byteOffset;
+      if (mismatch.expectedSize != mismatch.actualSize)
+        os << " (" << mismatch.actualSize << " bytes, expected " << mismatch.expectedSize << ")";
+      else
+        os << " of " << mismatch.expectedSize;
+      os << "\n";
+    }
+  }
+}
+
+//______________________________________________________________________________
+void GameManager::LogSnapshotSections(std::ostream& os, const SnapshotIndex& index)
+{
+  for (const SnapshotIndex::Section& section : index.Sections())
+  {
+    if (section.entity == SnapshotIndex::NoEntity)
+      os << "game ";
+    else
+      os << "entity " << section.entity << " ";
+    os << SnapshotPartName(section.part) << " @" << section.offset << " +" << section.size << " " << std::hex << section.hash << std::dec << "\n";
+  }
+}
+
+//______________________________________________________________________________
+void GameManager::Update(float deltaTime, SimulationPhase phase)
 {
   // makes a profile for the function its contained in
   PROFILE_FUNCTION();
 
+  SystemScheduler::Phase = phase;
   _currentScene->Update(_frameStopActive ? 0.0f : deltaTime);
+  SystemScheduler::Phase = SimulationPhase::Present;
   //! Do post update (update gui and change scene)
   PostUpdate();
 
@@ -699,15 +1042,49 @@ void GameManager::Update(float deltaTime)
 #ifdef _WIN32
   GGPOManager::Get().NotifyAdvanceFrame();
 #endif
+  RollbackManager::Get().NotifyAdvanceFrame();
 }
 
 //______________________________________________________________________________
-void GameManager::SyncPlayerInputs(InputState* inputs)
+void GameManager::SyncPlayerInputs(const InputState* inputs)
 {
   _p1->GetComponent<GameInputComponent>()->PushState(inputs[0]);
   _p2->GetComponent<GameInputComponent>()->PushState(inputs[1]);
 }
 
+//______________________________________________________________________________
+void GameManager::BeginRollbackSession(int localPlayer, std::unique_ptr<IRollbackTransport> transport)
+{
+  if (RollbackManager::Get().InMatch())
+    return;
+
+  // the other player is driven by the inputs the session syncs
+  std::shared_ptr<Entity> remote = localPlayer == 0 ? _p2 : _p1;
+  remote->GetComponent<GameInputComponent>()->AssignHandler(InputType::NetworkCtrl);
+
+  RollbackManager::Get().BeginSession(localPlayer, std::move(transport));
+}
+
+//______________________________________________________________________________
+void GameManager::StartMatch(const std::string& p1Character, const std::string& p2Character, BattleType type)
+{
+  // what the character select scene leaves on the players
+  _p1->AddComponent<SelectedCharacterComponent>();
+  _p1->GetComponent<SelectedCharacterComponent>()->characterIdentifier = p1Character;
+  _p2->AddComponent<SelectedCharacterComponent>();
+  _p2->GetComponent<SelectedCharacterComponent>()->characterIdentifier = p2Character;
+
+  _currentBattleType = type;
+  ChangeScene(SceneType::MATCH);
+}
+
+//______________________________________________________________________________
+void GameManager::AssignInputHandler(int player, InputType type)
+{
+  std::shared_ptr<Entity> entity = player == 0 ? _p1 : _p2;
+  entity->GetComponent<GameInputComponent>()->AssignHandler(type);
+}
+
 //______________________________________________________________________________
 void GameManager::RunFrame(float deltaTime)
 {
@@ -753,6 +1130,28 @@ void GameManager::RunFrame(float deltaTime)
   }
 #endif // _WIN32
 
+  if (RollbackManager::Get().InMatch())
+  {
+    // a simulated remote runs its frame first, as a real one would have by now
+    RollbackManager::Get().Tick();
+    if (!RollbackManager::Get().SyncInputs(inputs))
+    {
+      advanceFrame = false;
+    }
+  }
+
+  // the game stays on a rewound frame until it is resumed
+  if (_rewindPosition != NoRewind)
+    advanceFrame = false;
+
+  // a spectator runs the host's frames instead of its own
+  if (SpectatorManager::Get().Spectating())
+    advanceFrame = false;
+
+  // a replay records the inputs the frame runs with, or replaces them while one plays back
+  if (advanceFrame && !ReplayManager::Get().OnFrame(inputs))
+    advanceFrame = false;
+
   // advance frame with correct inputs assigned
   if (advanceFrame)
   {
@@ -760,9 +1159,56 @@ void GameManager::RunFrame(float deltaTime)
     _p2->GetComponent<GameInputComponent>()->PushState(inputs[1]);
 
     Update(deltaTime);
+    RecordRewindFrame();
+  }
 
+  SpectatorManager::Get().OnFrame();
+}
 
-  }
+//______________________________________________________________________________
+void GameManager::RecordRewindFrame()
+{
+  if (_currentSceneType != SceneType::MATCH || _currentBattleType != BattleType::Training)
+    return;
+  if (RollbackManager::Get().InMatch() || ReplayManager::Get().Playing() || SpectatorManager::Get().Spectating())
+    return;
+#ifdef _WIN32
+  if (GGPOManager::Get().InMatch())
+    return;
+#endif // _WIN32
+
+  if (!_rewind.Allocated())
+    _rewind.Allocate(RewindFrames, RewindCapacity);
+
+  // a full state, so any kept frame loads on its own whatever was dropped before it
+  const auto start = std::chrono::steady_clock::now();
+  const SnapshotWriter& state = WriteGameStateSnapshot();
+  _rewind.Push(_rewindFrame++, state.Data(), state.Size());
+  _rewindLastMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  _rewindMaxMicroseconds = std::max(_rewindMaxMicroseconds, _rewindLastMicroseconds);
+}
+
+//______________________________________________________________________________
+void GameManager::RewindTo(int i)
+{
+  if (i < 0 || i >= _rewind.Count() || _currentSceneType != SceneType::MATCH)
+    return;
+
+  // a recorded replay can't jump back in time
+  ReplayManager::Get().StopRecording();
+  LoadGamestateSnapshot(_rewind.DataAt(i), _rewind.SizeAt(i));
+  _rewindPosition = i;
+}
+
+//______________________________________________________________________________
+void GameManager::ResumeFromRewind()
+{
+  if (_rewindPosition == NoRewind)
+    return;
+
+  _rewind.TruncateAfter(_rewindPosition);
+  _rewindFrame = _rewind.FrameAt(_rewindPosition) + 1;
+  _rewindPosition = NoRewind;
 }
 
 //______________________________________________________________________________
@@ -771,6 +1217,11 @@ void GameManager::ChangeScene(SceneType scene)
   _currentScene.reset();
   ClearSceneData();
 
+  // kept frames belong to the scene that wrote them
+  _rewind.Clear();
+  _rewindFrame = 0;
+  _rewindPosition = NoRewind;
+
   _currentScene = std::unique_ptr<IScene>(SceneHelper::CreateScene(scene));
   if (scene == SceneType::MATCH)
   {
@@ -2,15 +2,24 @@
 
 #include "GameState/Scene.h"
 #include "Core/ECS/IComponent.h"
+#include "Core/ECS/EntitySet.h"
+#include "Core/ECS/SimulationPhase.h"
 #include "Core/Timer.h"
 #include "Rendering/RenderManager.h"
 #include "Core/InputState.h"
+#include "Core/Utility/SnapshotArena.h"
+#include "Core/Rollback/RollbackTransport.h"
+#include "Core/Rollback/SnapshotIndex.h"
+#include "Core/Rollback/SnapshotKeyframe.h"
+#include "Core/Rollback/RewindBuffer.h"
 
 #include <thread>
 #include <mutex>
 
 #define GRenderer RenderManager::Get()
 
+enum class InputType : int;
+
 //______________________________________________________________________________
 //! Manager of all things related to whats happening in the game
 class GameManager
@@ -20,15 +29,14 @@ public:
   static GameManager& Get() { static GameManager gm; return gm; }
   //! Checks if the Game Manager has been initialized
   bool Ready() const { return _initialized; }
-  //! Initialize the game manager, the SDL Library, and all game entities in the scene
-  void Initialize();
+  //! Initialize the game manager, the SDL Library, and all game entities in the scene. Headless skips the window and
+  //! GL context so the game can only be updated, not drawn
+  void Initialize(bool headless = false);
   //! Cleans up all SDL subsystems and destroys objects in correct order
   void Destroy();
   //! Starts the game loop. Returns when the game has been ended
   void BeginGameLoop();
 
-  void CheckAgainstSystems(Entity* entity);
-
   void ActivateHitStop(int frames);
 
   void DebugDraws();
@@ -37,10 +45,15 @@ public:
   //! Add entity to game entity list and add components to it
   template <class ... Args>
   std::shared_ptr<Entity> CreateEntity();
-  std::shared_ptr<Entity> GetEntityByID(int id) { return _gameEntities[id]; }
+  //! Non-owning O(1) lookup of a living entity (nullptr if there is none with this ID)
+  Entity* GetEntityByID(EntityID id) const { return id < _gameEntities.size() ? _gameEntities[id].get() : nullptr; }
+  //! Non-owning lookup that returns nullptr if the entity the handle was made for has been destroyed
+  Entity* GetEntity(const EntityHandle& handle) const { return EntityManager::Get().IsAlive(handle) ? GetEntityByID(handle.id) : nullptr; }
+  //! Shares ownership of the entity. Only for holders that need to keep it alive (scenes, players)
+  std::shared_ptr<Entity> ShareEntity(EntityID id) const { return id < _gameEntities.size() ? _gameEntities[id] : nullptr; }
   void DestroyEntity(std::shared_ptr<Entity> entity);
   void DestroyEntity(const EntityID& entity);
-  void AddToNetworkedList(const EntityID& entity) { _networkedEntities.push_back(entity); }
+  void AddToNetworkedList(const EntityID& entity) { _networkedEntities.push_back(entity); _networkedSet.insert(entity); }
 
   //! request scene change at end of update loop
   void RequestSceneChange(SceneType newSceneType);
@@ -48,6 +61,10 @@ public:
   void AdvanceCurrentScene();
   //!
   void SetBattleType(BattleType type) { _currentBattleType = type; }
+  BattleType GetBattleType() const { return _currentBattleType; }
+  SceneType GetSceneType() const { return _currentSceneType; }
+  //! Entity of the player (0 or 1)
+  std::shared_ptr<Entity> GetPlayer(int player) const { return player == 0 ? _p1 : _p2; }
   //! Schedules a function to be ran when scene is changed
   void TriggerOnSceneChange(std::function<void()> fn)
   {
@@ -65,17 +82,41 @@ public:
     _beginningOfFrameQueue.push_back(fn);
   }
 
-  //! Creates a snapshot of all of the current entities' states (prepending the EntityID before each entity state is written)
+  //! Frames between two rollback keyframes. Has to be more than the frames a rollback can go back, so that a frame
+  //! that can still be loaded never refers to a keyframe older than the last two
+  static constexpr int KeyframeInterval = 60;
+
+  //! Writes a snapshot of all of the current entities' states (prepending the EntityID before each entity state is written)
+  //! into the writer's arena, replacing what it held. If given, the index gets a section per entity and component
+  void WriteGameStateSnapshot(SnapshotWriter& writer, SnapshotIndex* index = nullptr) const { WriteSnapshot(writer, index, nullptr, false, nullptr); }
+  //! Writes the snapshot of a rollback frame. Every KeyframeInterval frames the snapshot is complete and kept as a
+  //! keyframe. The frames in between leave out the plain data components that haven't changed since the keyframe
+  void WriteRollbackSnapshot(int frame, SnapshotWriter& writer, SnapshotIndex& index);
+  //! Writes a snapshot into the reusable snapshot arena. The bytes are valid until the next call
+  const SnapshotWriter& WriteGameStateSnapshot() const { WriteGameStateSnapshot(_snapshotWriter); return _snapshotWriter; }
+  //! Creates a snapshot as above and copies it out of the arena
   SBuffer CreateGameStateSnapshot() const;
+  //! Loads a snapshot of the game state in place
+  void LoadGamestateSnapshot(const char* data, size_t size);
   //! Loads the snapshot of the current game state
-  void LoadGamestateSnapshot(const SBuffer& snapshot);
+  void LoadGamestateSnapshot(const SBuffer& snapshot) { LoadGamestateSnapshot(snapshot.data(), snapshot.size()); }
   //! 
   std::string LogGamestate();
+  //! Writes one line per differing section of a snapshot (entity, component and first differing byte)
+  static void LogSnapshotMismatches(std::ostream& os, const std::vector<SnapshotIndex::Mismatch>& mismatches);
+  //! Writes one line per section of a snapshot (entity, component, where it is and its hash)
+  static void LogSnapshotSections(std::ostream& os, const SnapshotIndex& index);
 
-  //! Updates all components in specified order
-  void Update(float deltaTime);
+  //! Updates all components in specified order. Resimulated frames skip the presentation systems
+  void Update(float deltaTime, SimulationPhase phase = SimulationPhase::Present);
   //! Updates player input after a sync
-  void SyncPlayerInputs(InputState* inputs);
+  void SyncPlayerInputs(const InputState* inputs);
+  //! Starts a portable rollback match against the remote on the other end of the transport
+  void BeginRollbackSession(int localPlayer, std::unique_ptr<IRollbackTransport> transport);
+  //! Goes straight to a match with the characters, skipping the menus
+  void StartMatch(const std::string& p1Character, const std::string& p2Character, BattleType type);
+  //! Changes where a player's (0 or 1) inputs come from
+  void AssignInputHandler(int player, InputType type);
 
 
 private:
@@ -91,6 +132,15 @@ private:
   void Draw();
   //! Destroys marked entities and clears scene change queue
   void ClearSceneData();
+  //! Keeps the state the frame ended on for rewinding, in training matches played locally
+  void RecordRewindFrame();
+  //! Loads the i-th frame kept for rewinding and holds the game on it
+  void RewindTo(int i);
+  //! Lets the game run on from the frame rewound to, dropping the frames that were kept after it
+  void ResumeFromRewind();
+  //! Writes a snapshot. Against a keyframe, the plain data components that match it are left out (see
+  //! SerializeComponentArray for useDirty). If capture is given, the plain data arrays are copied into it
+  void WriteSnapshot(SnapshotWriter& writer, SnapshotIndex* index, const SnapshotKeyframe* keyframe, bool useDirty, SnapshotKeyframe* capture) const;
   //! Flag for whether or not the GM has been initialized
   bool _initialized;
   //!
@@ -122,6 +172,32 @@ private:
   std::vector<SBuffer> _p1Snapshots;
   std::vector<SBuffer> _p2Snapshots;
   std::vector<SBuffer> _gameStateSnapshots;
+
+  //! Arena rollback snapshots are written into, reused every frame
+  mutable SnapshotWriter _snapshotWriter;
+  //! Stream over the snapshot being loaded
+  SnapshotReader _snapshotReader;
+  //! Stream over the keyframe arrays under the snapshot being loaded
+  SnapshotReader _keyframeReader;
+  //! The last two rollback keyframes, by keyframe number (frame / KeyframeInterval) modulo 2
+  SnapshotKeyframe _keyframes[2];
+  //! Keyframe the component dirty flags were last cleared at (NoFrame if they haven't been)
+  int _cleanSinceKeyframe = SnapshotKeyframe::NoFrame;
+
+  //! Frames kept for rewinding a training match (about 10 seconds at 60 fps)
+  static constexpr size_t RewindFrames = 600;
+  //! Memory they are kept in, older frames are dropped early if the states are bigger than expected
+  static constexpr size_t RewindCapacity = 16 * 1024 * 1024;
+  //! States of the last frames of a training match
+  RewindBuffer _rewind;
+  //! Frames recorded since the match started, numbering the kept states
+  int _rewindFrame = 0;
+  //! Kept frame the game is held on, NoRewind while it runs
+  static constexpr int NoRewind = -1;
+  int _rewindPosition = NoRewind;
+  //! Time spent keeping the last frame, and the most it took
+  long long _rewindLastMicroseconds = 0;
+  long long _rewindMaxMicroseconds = 0;
   
 
   //______________________________________________________________________________
@@ -133,10 +209,12 @@ private:
   template <typename T = IComponent, typename ... Rest>
   static auto ComponentExistsOnEntity(Entity* entity);
 
-  //! All entities in the scene
-  std::unordered_map<EntityID, std::shared_ptr<Entity>> _gameEntities;
+  //! All entities in the scene, indexed by entity ID (slots are recycled by the EntityManager with a new generation)
+  std::vector<std::shared_ptr<Entity>> _gameEntities;
   //! Game state dependent entities that must be transferred by the network
   std::vector<EntityID> _networkedEntities;
+  //! Same entities as a set, to pick them out of the component arrays written in bulk
+  EntitySet _networkedSet;
   //!
   std::shared_ptr<Entity> _p1, _p2;
 
@@ -156,13 +234,15 @@ template <typename T, typename ... Rest>
 inline auto GameManager::AddComponentToEntity(Entity* entity) -> std::enable_if_t<!std::is_void<T>::value>
 {
   // recursive control path enders
-  if (!all_base_of<IComponent, T, Rest...>() || std::is_same_v<T, IComponent>)
+  if constexpr (!AllComponents<T, Rest...> || std::is_same_v<T, IComponent>)
     return;
-
-  // Add the current component
-  entity->AddComponent<T>();
-  // recursively call this function on the rest of the types
-  return AddComponentToEntity<Rest...>(entity);
+  else
+  {
+    // Add the current component
+    entity->AddComponent<T>();
+    // recursively call this function on the rest of the types
+    return AddComponentToEntity<Rest...>(entity);
+  }
 }
 
 //______________________________________________________________________________
@@ -170,9 +250,10 @@ template <typename T, typename ... Rest>
 inline auto GameManager::ComponentExistsOnEntity(Entity* entity)
 {
   // recursive control path enders
-  if (!all_base_of<IComponent, T, Rest...>() || std::is_same_v<T, IComponent>)
+  if constexpr (!AllComponents<T, Rest...> || std::is_same_v<T, IComponent>)
     return true;
-  return entity->GetComponent<T>() && ComponentExistsOnEntity<Rest...>(entity);
+  else
+    return entity->GetComponent<T>() && ComponentExistsOnEntity<Rest...>(entity);
 }
 
 //______________________________________________________________________________
@@ -180,8 +261,13 @@ template <class ... Args>
 inline std::shared_ptr<Entity> GameManager::CreateEntity()
 {
   auto entityPtr = std::make_shared<Entity>();
-  _gameEntities[entityPtr->GetID()] = entityPtr;
+  const EntityID id = entityPtr->GetID();
+  assert(id != EntityManager::InvalidEntity && "Entity cap reached.");
+
+  if (id >= _gameEntities.size())
+    _gameEntities.resize(id + 1);
+  _gameEntities[id] = entityPtr;
 
-  AddComponentToEntity<Args...>(_gameEntities[entityPtr->GetID()].get());
+  AddComponentToEntity<Args...>(entityPtr.get());
   return entityPtr;
 }
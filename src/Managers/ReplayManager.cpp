@@ -0,0 +1,106 @@
+#include "Managers/ReplayManager.h"
+#include "Managers/GameManagement.h"
+#include "Managers/GGPOManager.h"
+#include "Managers/RollbackManager.h"
+
+#include "Components/MetaGameComponents.h"
+
+#include <algorithm>
+#include <chrono>
+
+//______________________________________________________________________________
+bool ReplayManager::StartRecording(int keyframeInterval)
+{
+  GameManager& game = GameManager::Get();
+  if (_playing || game.GetSceneType() != SceneType::MATCH || RollbackManager::Get().InMatch())
+    return false;
+#ifdef _WIN32
+  if (GGPOManager::Get().InMatch())
+    return false;
+#endif
+
+  Replay::Header header;
+  header.p1Character = game.GetPlayer(0)->GetComponent<SelectedCharacterComponent>()->characterIdentifier;
+  header.p2Character = game.GetPlayer(1)->GetComponent<SelectedCharacterComponent>()->characterIdentifier;
+  header.battleType = static_cast<int>(game.GetBattleType());
+  header.keyframeInterval = keyframeInterval;
+  _replay.Reset(header);
+
+  // the first keyframe is taken when the first frame runs
+  _frame = 0;
+  _recording = true;
+  return true;
+}
+
+//______________________________________________________________________________
+bool ReplayManager::StartPlayback()
+{
+  if (_recording || !_replay.KeyframeBefore(0))
+    return false;
+
+  const Replay::Header& header = _replay.GetHeader();
+  GameManager::Get().StartMatch(header.p1Character, header.p2Character, static_cast<BattleType>(header.battleType));
+
+  _playing = true;
+  _paused = false;
+  // anything before the first keyframe is unknown, so start from a load rather than what StartMatch set up
+  _frame = -1;
+  Seek(0);
+  return true;
+}
+
+//______________________________________________________________________________
+bool ReplayManager::OnFrame(InputState* inputs)
+{
+  // a replay covers one match, leaving it ends the recording
+  if (_recording && GameManager::Get().GetSceneType() != SceneType::MATCH)
+    _recording = false;
+
+  if (_recording)
+  {
+    if (_replay.WantsKeyframe(_frame))
+      _replay.AddKeyframe(_frame, GameManager::Get().CreateGameStateSnapshot());
+    _replay.AddFrame(inputs);
+    _frame++;
+    return true;
+  }
+
+  if (_playing)
+  {
+    if (_paused || _frame >= _replay.Frames())
+      return false;
+    std::copy_n(_replay.FrameInputs(_frame), Replay::NumPlayers, inputs);
+    _frame++;
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+void ReplayManager::Seek(int frame)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  frame = std::clamp(frame, 0, _replay.Frames());
+  const Replay::Keyframe* keyframe = _replay.KeyframeBefore(frame);
+  if (!keyframe)
+    return;
+
+  // running on from the current frame is cheaper than a load when it is already past the keyframe
+  int from = _frame;
+  if (from < keyframe->frame || from > frame)
+  {
+    GameManager::Get().LoadGamestateSnapshot(keyframe->state);
+    from = keyframe->frame;
+  }
+
+  // only the frame landed on is presented, the ones before it just catch the state up
+  for (int f = from; f < frame; f++)
+  {
+    GameManager::Get().SyncPlayerInputs(_replay.FrameInputs(f));
+    GameManager::Get().Update(secPerFrame, f + 1 == frame ? SimulationPhase::Present : SimulationPhase::Resimulate);
+  }
+  _frame = frame;
+
+  _lastSeekFrames = frame - from;
+  _lastSeekMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
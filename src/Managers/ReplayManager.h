@@ -0,0 +1,59 @@
+#pragma once
+#include "Core/Rollback/Replay.h"
+
+//______________________________________________________________________________
+//! Records the match being played into a Replay and plays replays back through the GameManager. Playback replaces the
+//! local inputs with the recorded ones. Seeking loads the last keyframe before the frame and runs the recorded frames
+//! from there in one go, as resimulated frames that aren't drawn
+class ReplayManager
+{
+public:
+  static ReplayManager& Get()
+  {
+    static ReplayManager instance;
+    return instance;
+  }
+
+  //! Starts recording the match being played from its current state. Returns false if there is no match, a replay is
+  //! playing or the match is online (predicted inputs would be recorded)
+  bool StartRecording(int keyframeInterval = Replay::DefaultKeyframeInterval);
+  void StopRecording() { _recording = false; }
+  bool Recording() const { return _recording; }
+
+  //! Sets up the match the replay was recorded in and puts it at the first recorded frame. Run it between frames
+  bool StartPlayback();
+  void StopPlayback() { _playing = false; }
+  bool Playing() const { return _playing; }
+  void SetPaused(bool paused) { _paused = paused; }
+  bool Paused() const { return _paused; }
+
+  //! Called by the game loop with the inputs of the frame about to run. Recording adds them, and a keyframe of the
+  //! state when one is due. Playback replaces them with the recorded ones. Returns false if the frame shouldn't run
+  //! (playback paused or at the end)
+  bool OnFrame(InputState* inputs);
+  //! Puts the game at the start of the recorded frame. Run it between frames
+  void Seek(int frame);
+
+  //! Frame that runs next, while recording or playing
+  int CurrentFrame() const { return _frame; }
+  Replay& GetReplay() { return _replay; }
+  //! Frames the last seek ran and how long it took in microseconds (load included)
+  int LastSeekFrames() const { return _lastSeekFrames; }
+  long long LastSeekMicroseconds() const { return _lastSeekMicroseconds; }
+
+private:
+  ReplayManager() = default;
+  ~ReplayManager() = default;
+  ReplayManager(const ReplayManager&) = delete;
+  ReplayManager operator=(const ReplayManager&) = delete;
+
+  Replay _replay;
+  bool _recording = false;
+  bool _playing = false;
+  bool _paused = false;
+  int _frame = 0;
+
+  int _lastSeekFrames = 0;
+  long long _lastSeekMicroseconds = 0;
+
+};
@@ -0,0 +1,134 @@
+#include "Managers/RollbackManager.h"
+#include "Managers/GameManagement.h"
+
+//______________________________________________________________________________
+//! Remote end of a simulated session. It has no game, only inputs: it runs the session's frames as soon as the
+//! session lets it, holding seeded random inputs for a few frames at a time so predictions of them go wrong
+class RollbackManager::SimulatedRemote : public IRollbackGame
+{
+public:
+  SimulatedRemote(std::unique_ptr<IRollbackTransport> transport, int player, uint32_t seed) :
+    _session(*this, std::move(transport), player, NetGlobals::FrameDelay, NetGlobals::MaxPredictionFrames), _player(player), _rng(seed) {}
+
+  void Tick()
+  {
+    InputState inputs[RollbackSession::NumPlayers];
+    if (_holdFrames-- <= 0)
+    {
+      _held = NextInput();
+      _holdFrames = 1 + static_cast<int>(_rng.Below(12));
+    }
+    inputs[_player] = _held;
+
+    if (_session.SyncInputs(inputs))
+      _session.AdvanceFrame();
+  }
+
+  //! Nothing to save, load or run
+  void SaveGameState(int frame, SnapshotWriter& writer, SnapshotIndex& index) override {}
+  bool LoadGameState(const char* data, size_t size) override { return true; }
+  void AdvanceFrame(const InputState* inputs, SimulationPhase phase) override { _session.AdvanceFrame(); }
+
+private:
+  InputState NextInput()
+  {
+    static const InputState directions[] = { InputState::NONE, InputState::LEFT, InputState::RIGHT, InputState::DOWN, InputState::UP,
+      InputState::DOWN | InputState::LEFT, InputState::DOWN | InputState::RIGHT };
+    static const InputState buttons[] = { InputState::BTN1, InputState::BTN2, InputState::BTN3, InputState::BTN4 };
+
+    InputState input = directions[_rng.Below(7)];
+    if (_rng.Below(4) == 0)
+      input |= buttons[_rng.Below(4)];
+    return input;
+  }
+
+  RollbackSession _session;
+  int _player;
+  SeededRandom _rng;
+  InputState _held = InputState::NONE;
+  int _holdFrames = 0;
+
+};
+
+//______________________________________________________________________________
+RollbackManager::RollbackManager() = default;
+
+//______________________________________________________________________________
+RollbackManager::~RollbackManager() = default;
+
+//______________________________________________________________________________
+void RollbackManager::BeginSession(int localPlayer, std::unique_ptr<IRollbackTransport> transport)
+{
+  if (_session)
+    return;
+
+  _session = std::make_unique<RollbackSession>(*this, std::move(transport), localPlayer, NetGlobals::FrameDelay, NetGlobals::MaxPredictionFrames);
+  _sessionSerial++;
+
+  if (!_logPath.empty())
+  {
+    _log.open(_logPath, std::ios::out | std::ios::trunc);
+    if (_log)
+      _session->SetLog(&_log);
+  }
+}
+
+//______________________________________________________________________________
+void RollbackManager::BeginSimulatedSession(int localPlayer, const NetworkConditions& conditions)
+{
+  if (_session)
+    return;
+
+  // both directions are shaped the same way, each with its own draws
+  _simulatedFrames = 0;
+  auto clock = [this]() { return _simulatedFrames * 1000 / 60; };
+  NetworkConditions remoteConditions = conditions;
+  remoteConditions.seed = conditions.seed + 1;
+
+  auto link = LoopbackTransport::CreatePair();
+  auto local = std::make_unique<ConditionedTransport>(std::move(link.first), conditions, clock);
+  auto remote = std::make_unique<ConditionedTransport>(std::move(link.second), remoteConditions, clock);
+
+  _remote = std::make_unique<SimulatedRemote>(std::move(remote), 1 - localPlayer, conditions.seed);
+  GameManager::Get().BeginRollbackSession(localPlayer, std::move(local));
+}
+
+//______________________________________________________________________________
+void RollbackManager::ExitSession()
+{
+  _session.reset();
+  _remote.reset();
+  if (_log.is_open())
+    _log.close();
+}
+
+//______________________________________________________________________________
+void RollbackManager::Tick()
+{
+  if (!_remote)
+    return;
+
+  _simulatedFrames++;
+  _remote->Tick();
+}
+
+//______________________________________________________________________________
+void RollbackManager::SaveGameState(int frame, SnapshotWriter& writer, SnapshotIndex& index)
+{
+  GameManager::Get().WriteRollbackSnapshot(frame, writer, index);
+}
+
+//______________________________________________________________________________
+bool RollbackManager::LoadGameState(const char* data, size_t size)
+{
+  GameManager::Get().LoadGamestateSnapshot(data, size);
+  return true;
+}
+
+//______________________________________________________________________________
+void RollbackManager::AdvanceFrame(const InputState* inputs, SimulationPhase phase)
+{
+  // same as a frame ran by the game loop: push the inputs then update (which notifies the session at the end)
+  GameManager::Get().SyncPlayerInputs(inputs);
+  GameManager::Get().Update(secPerFrame, phase);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Core/Rollback/RollbackSession.h"
+#include "Core/Rollback/ConditionedTransport.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+//______________________________________________________________________________
+//! Runs the engine's portable rollback session (the counterpart of GGPOManager that works on every platform).
+//! Implements the session's game hooks on top of the GameManager
+class RollbackManager : public IRollbackGame
+{
+public:
+  static RollbackManager& Get()
+  {
+    static RollbackManager instance;
+    return instance;
+  }
+
+  //! Starts a session with the remote on the other end of the transport
+  void BeginSession(int localPlayer, std::unique_ptr<IRollbackTransport> transport);
+  //! Starts a session against a remote peer simulated in this process, both ends linked through the network
+  //! conditions. The remote plays seeded random inputs and time is counted in frames, so the same conditions and seed
+  //! roll back the same way every run
+  void BeginSimulatedSession(int localPlayer, const NetworkConditions& conditions);
+  //! Ends the session
+  void ExitSession();
+  //! Runs the simulated remote's frame and moves the simulated time along. Call once per frame, before SyncInputs
+  void Tick();
+  //! Whether the remote is simulated
+  bool Simulated() const { return _remote != nullptr; }
+
+  //! File the next sessions log their rollbacks per second to (see RollbackSession::SetLog), empty to not log
+  void SetLogPath(const std::string& path) { _logPath = path; }
+  const std::string& GetLogPath() const { return _logPath; }
+  //! returns true if we are in a rollback match
+  bool InMatch() const { return _session != nullptr; }
+  //! Current session, nullptr if not in a match
+  RollbackSession* GetSession() { return _session.get(); }
+  //! Number of the current or last session, counting from 1. Tells a new session apart from the one before it
+  int GetSessionSerial() const { return _sessionSerial; }
+
+  //! returns true if frame should advance. input should be an array of RollbackSession::NumPlayers length
+  bool SyncInputs(InputState* input) { return _session->SyncInputs(input); }
+  //! used by game manager to notify the session that the frame has been updated
+  void NotifyAdvanceFrame() { if (_session) _session->AdvanceFrame(); }
+  //! receive remote inputs and roll back while waiting for the next frame
+  void Idle() { if (_session) _session->Idle(); }
+
+  //! IRollbackGame hooks
+  void SaveGameState(int frame, SnapshotWriter& writer, SnapshotIndex& index) override;
+  bool LoadGameState(const char* data, size_t size) override;
+  void AdvanceFrame(const InputState* inputs, SimulationPhase phase) override;
+
+private:
+  class SimulatedRemote;
+
+  RollbackManager();
+  ~RollbackManager();
+  RollbackManager(const RollbackManager&) = delete;
+  RollbackManager operator=(const RollbackManager&) = delete;
+
+  std::unique_ptr<RollbackSession> _session;
+  int _sessionSerial = 0;
+  //! Other end of a simulated session
+  std::unique_ptr<SimulatedRemote> _remote;
+  //! Frames since the simulated session started, its clock
+  int64_t _simulatedFrames = 0;
+
+  std::string _logPath;
+  std::ofstream _log;
+
+};
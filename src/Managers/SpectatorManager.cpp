@@ -0,0 +1,83 @@
+#include "Managers/SpectatorManager.h"
+#include "Managers/GameManagement.h"
+#include "Managers/RollbackManager.h"
+
+#include "Components/MetaGameComponents.h"
+
+#include <sstream>
+
+//______________________________________________________________________________
+void SpectatorManager::BeginSpectating(std::unique_ptr<IRollbackTransport> transport)
+{
+  if (_spectating || RollbackManager::Get().InMatch())
+    return;
+
+  _spectating = std::make_unique<SpectatorSession>(*this, std::move(transport));
+}
+
+//______________________________________________________________________________
+void SpectatorManager::OnFrame()
+{
+  if (_spectating)
+  {
+    _spectating->Tick();
+    return;
+  }
+
+  RollbackSession* session = RollbackManager::Get().GetSession();
+  if (!session)
+    return;
+
+  // a new session can be allocated where the last one was, so it is told apart by its serial
+  const int serial = RollbackManager::Get().GetSessionSerial();
+  if (serial != _relayedSerial)
+  {
+    _relay.Reset();
+    _relayedSerial = serial;
+  }
+
+  // spectators can only be set up in a match, the menus before it wait
+  const bool inMatch = GameManager::Get().GetSceneType() == SceneType::MATCH;
+  _relay.Update(*session, inMatch, [this](std::vector<char>& state) { WriteState(state); });
+}
+
+//______________________________________________________________________________
+void SpectatorManager::WriteState(std::vector<char>& state) const
+{
+  GameManager& game = GameManager::Get();
+  std::ostringstream stream(std::ios::binary);
+  Serializer<std::string>::Serialize(stream, game.GetPlayer(0)->GetComponent<SelectedCharacterComponent>()->characterIdentifier);
+  Serializer<std::string>::Serialize(stream, game.GetPlayer(1)->GetComponent<SelectedCharacterComponent>()->characterIdentifier);
+  Serializer<int>::Serialize(stream, static_cast<int>(game.GetBattleType()));
+
+  const std::string setup = stream.str();
+  const SnapshotWriter& snapshot = game.WriteGameStateSnapshot();
+  state.assign(setup.begin(), setup.end());
+  state.insert(state.end(), snapshot.Data(), snapshot.Data() + snapshot.Size());
+}
+
+//______________________________________________________________________________
+bool SpectatorManager::LoadGameState(const char* data, size_t size)
+{
+  std::istringstream stream(std::string(data, size), std::ios::binary);
+  std::string p1Character, p2Character;
+  int battleType = 0;
+  Serializer<std::string>::Deserialize(stream, p1Character);
+  Serializer<std::string>::Deserialize(stream, p2Character);
+  Serializer<int>::Deserialize(stream, battleType);
+  if (!stream)
+    return false;
+
+  // the snapshot loads into the match it was written in, so set that up first
+  GameManager::Get().StartMatch(p1Character, p2Character, static_cast<BattleType>(battleType));
+  const size_t setupSize = static_cast<size_t>(stream.tellg());
+  GameManager::Get().LoadGamestateSnapshot(data + setupSize, size - setupSize);
+  return true;
+}
+
+//______________________________________________________________________________
+void SpectatorManager::AdvanceFrame(const InputState* inputs, SimulationPhase phase)
+{
+  GameManager::Get().SyncPlayerInputs(inputs);
+  GameManager::Get().Update(secPerFrame, phase);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Core/Rollback/SpectatorRelay.h"
+
+#include <memory>
+
+//______________________________________________________________________________
+//! Spectating a rollback match. A player of the match hosts spectators through a SpectatorRelay, a spectator runs a
+//! SpectatorSession that loads the state the host sends (with the match it needs set up) and runs the frames. The
+//! spectators don't take part in the session, the players never wait for them
+class SpectatorManager : public IRollbackGame
+{
+public:
+  static SpectatorManager& Get()
+  {
+    static SpectatorManager instance;
+    return instance;
+  }
+
+  //! Sends the match being played to the spectator on the other end of the transport
+  void AddSpectator(std::unique_ptr<IRollbackTransport> transport) { _relay.AddSpectator(std::move(transport)); }
+  void RemoveSpectators() { _relay.RemoveSpectators(); }
+  const SpectatorRelay& GetRelay() const { return _relay; }
+
+  //! Spectates the match of the host on the other end of the transport
+  void BeginSpectating(std::unique_ptr<IRollbackTransport> transport);
+  void StopSpectating() { _spectating.reset(); }
+  bool Spectating() const { return _spectating != nullptr; }
+  const SpectatorSession* GetSpectatorSession() const { return _spectating.get(); }
+
+  //! Called by the game loop once per frame, after the frame ran. Keeps the relay up to date with the rollback match
+  //! being played, and runs the spectated frames
+  void OnFrame();
+
+  //! IRollbackGame hooks for the spectator session. The state is the match setup followed by a game state snapshot
+  void SaveGameState(int frame, SnapshotWriter& writer, SnapshotIndex& index) override {}
+  bool LoadGameState(const char* data, size_t size) override;
+  void AdvanceFrame(const InputState* inputs, SimulationPhase phase) override;
+
+private:
+  SpectatorManager() = default;
+  ~SpectatorManager() = default;
+  SpectatorManager(const SpectatorManager&) = delete;
+  SpectatorManager operator=(const SpectatorManager&) = delete;
+
+  //! Writes the match setup and the current state
+  void WriteState(std::vector<char>& state) const;
+
+  SpectatorRelay _relay;
+  //! Serial of the session the relay follows (0 for none), the relay starts over with a new one
+  int _relayedSerial = 0;
+  std::unique_ptr<SpectatorSession> _spectating;
+
+};
@@ -1,4 +1,6 @@
 #include "Rendering/GLTexture.h"
+#include "Rendering/RenderManager.h"
+
 #include <memory>
 #include <stdexcept>
 
@@ -88,6 +90,9 @@ void GLTexture::CreateEmpty(int width, int height, Uint32 format)
 //______________________________________________________________________________
 void GLTexture::Update(void* pixels)
 {
+  if (RenderManager::Get().IsHeadless())
+    return;
+
   glBindTexture(GL_TEXTURE_2D, _textureId);
 
   GLenum scaleMode = GetScaleQuality();
@@ -126,6 +131,12 @@ void GLTexture::SetTextureParameters(SDL_Surface* textureData)
 
   SDL_GetSurfaceBlendMode(textureData, &_blendMode);
 
+  _w = textureData->w;
+  _h = textureData->h;
+
+  // no context to upload to, the size is all that's used
+  if (RenderManager::Get().IsHeadless())
+    return;
 
   // set up the gl texture after  the internal format has been parsed
   glGenTextures(1, &_textureId);
@@ -139,8 +150,5 @@ void GLTexture::SetTextureParameters(SDL_Surface* textureData)
 
   glColor4f(1.0, 1.0, 1.0, 1.0);
 
-  _w = textureData->w;
-  _h = textureData->h;
-
   glTexImage2D(GL_TEXTURE_2D, 0, _internalFormat, textureData->w, textureData->h, 0, _textureFormat, _type, textureData->pixels);
 }
@@ -69,9 +69,9 @@ private:
   void SetTextureParameters(SDL_Surface* textureData);
 
   // width and height of texture in pixels
-  int _w, _h;
-  // specifies name of texture as it is bound by the open gl context
-  GLuint _textureId;
+  int _w = 0, _h = 0;
+  // specifies name of texture as it is bound by the open gl context (0 when no texture has been made)
+  GLuint _textureId = 0;
   // Specifies the data type of the pixel data
   // GL_UNSIGNED_BYTE, GL_BYTE, GL_UNSIGNED_SHORT, GL_SHORT, GL_UNSIGNED_INT, GL_INT, GL_HALF_FLOAT, GL_FLOAT, GL_UNSIGNED_SHORT_5_6_5, GL_UNSIGNED_SHORT_4_4_4_4, GL_UNSIGNED_SHORT_5_5_5_1,
   // GL_UNSIGNED_INT_2_10_10_10_REV, GL_UNSIGNED_INT_10F_11F_11F_REV, GL_UNSIGNED_INT_5_9_9_9_REV, GL_UNSIGNED_INT_24_8, and GL_FLOAT_32_UNSIGNED_INT_24_8_REV.
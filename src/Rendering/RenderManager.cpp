@@ -114,6 +114,8 @@ RenderManager::RenderManager() :
   _renderer(nullptr),
   _window(nullptr),
   _glContext(nullptr),
+  _offscreen(nullptr),
+  _headless(false),
   _renderScale(1.0, 1.0) {}
 
 //______________________________________________________________________________
@@ -150,15 +152,35 @@ void RenderManager::Init()
 #endif
 }
 
+//______________________________________________________________________________
+void RenderManager::InitHeadless()
+{
+  SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS);
+  TTF_Init();
+
+  _headless = true;
+  _sdlWindowFormat = SDL_PIXELFORMAT_RGBA8888;
+
+  // sprite sheets and text are still loaded as SDL textures (their sizes and pixels are used by the game), so give
+  // them a renderer that doesn't need a window
+  _offscreen = SDL_CreateRGBSurfaceWithFormat(0, m_nativeWidth, m_nativeHeight, 32, _sdlWindowFormat);
+  _renderer = SDL_CreateSoftwareRenderer(_offscreen);
+  SDL_SetRenderDrawBlendMode(_renderer, SDL_BLENDMODE_BLEND);
+}
+
 //______________________________________________________________________________
 void RenderManager::Destroy()
 {
   SDL_DestroyRenderer(_renderer);
-  SDL_DestroyWindow(_window);
+  if (_window)
+    SDL_DestroyWindow(_window);
   SDL_GL_DeleteContext(_glContext);
+  if (_offscreen)
+    SDL_FreeSurface(_offscreen);
 
   _renderer = nullptr;
   _window = nullptr;
+  _offscreen = nullptr;
 
   SDL_Quit();
   TTF_Quit();
@@ -214,6 +236,9 @@ void RenderManager::SwitchTo3D()
 //______________________________________________________________________________
 void RenderManager::Draw()
 {
+  if (_headless)
+    return;
+
   SwitchTo3D();
   Draw3DBackground();
   SwitchTo2D();
@@ -230,6 +255,9 @@ void RenderManager::Draw()
 //______________________________________________________________________________
 void RenderManager::Clear()
 {
+  if (_headless)
+    return;
+
   // clear previous render
   glClearColor(0.0, 0.0, 0.0, 1);
   glClear(GL_COLOR_BUFFER_BIT);
@@ -241,6 +269,9 @@ void RenderManager::Clear()
 //______________________________________________________________________________
 void RenderManager::Present()
 {
+  if (_headless)
+    return;
+
   SDL_GL_SwapWindow(_window);
 }
 
@@ -88,6 +88,11 @@ public:
   static RenderManager& Get() { static RenderManager rm; return rm; }
   //! Inits SDL for GL and regular SDL rendering
   void Init();
+  //! Inits SDL without video, a window or a GL context. SDL textures are backed by a software renderer drawing
+  //! offscreen and GL textures only keep their size. Used by tools that simulate the game without presenting it
+  void InitHeadless();
+  //! Whether there is no window or GL context to draw to
+  bool IsHeadless() const { return _headless; }
   //! Destroys renderer and window
   void Destroy();
   //!
@@ -170,6 +175,10 @@ private:
   SDL_Window* _window;
   //! SDL Gl Context pointer - only used for gl texture rendering. SDL_GLContext is just an alias for void*
   void* _glContext;
+  //! Surface the software renderer draws into when headless
+  SDL_Surface* _offscreen;
+  //!
+  bool _headless;
   //! Rendering scale for window resize
   Vector2<double> _renderScale;
   //!
@@ -0,0 +1,207 @@
+// SyncTestMain.cpp : Entry point of the headless sync test. Runs a training match without a window, rolling back
+// every frame, and reports the first frame that doesn't match a run without rollbacks.
+//
+// usage: FGDuelSyncTest [--frames N] [--rollback N] [--seed N] [--inputs file] [--p1 character] [--p2 character] [--serial] [--measure]
+//   --inputs reads one frame per line, the two players' InputState bits as integers ("16 0"). Frames past the end of
+//   the file have no input. Without it both players mash seeded random inputs
+//   --measure only runs the frames straight through, saving each one, and reports the size of the states and the time
+//   to save them. Nothing is compared, so it also measures a game that doesn't pass
+#include "Managers/GameManagement.h"
+#include "Managers/ResourceManager.h"
+#include "Managers/AnimationCollectionManager.h"
+#include "Managers/RollbackManager.h"
+
+#include "Components/Input.h"
+#include "Core/ECS/SystemScheduler.h"
+#include "Core/Rollback/ConditionedTransport.h"
+#include "Core/Rollback/SyncTest.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#undef main
+#endif
+
+//______________________________________________________________________________
+//! Random inputs held for a few frames at a time, so moves and specials actually come out. A failing seed reproduces
+//! on any platform
+class RandomInputs
+{
+public:
+  explicit RandomInputs(unsigned int seed) : _rng(seed) {}
+
+  void operator()(int frame, InputState* inputs)
+  {
+    for (int player = 0; player < RollbackSession::NumPlayers; player++)
+    {
+      if (_holdFrames[player]-- <= 0)
+      {
+        _held[player] = Next();
+        _holdFrames[player] = 1 + static_cast<int>(_rng.Below(12));
+      }
+      inputs[player] = _held[player];
+    }
+  }
+
+private:
+  InputState Next()
+  {
+    static const InputState directions[] = { InputState::NONE, InputState::UP, InputState::DOWN, InputState::LEFT, InputState::RIGHT,
+      InputState::UP | InputState::LEFT, InputState::UP | InputState::RIGHT, InputState::DOWN | InputState::LEFT, InputState::DOWN | InputState::RIGHT };
+    static const InputState buttons[] = { InputState::BTN1, InputState::BTN2, InputState::BTN3, InputState::BTN4 };
+
+    InputState input = directions[_rng.Below(9)];
+    if (_rng.Below(4) == 0)
+      input |= buttons[_rng.Below(4)];
+    return input;
+  }
+
+  SeededRandom _rng;
+  InputState _held[RollbackSession::NumPlayers] = { InputState::NONE, InputState::NONE };
+  int _holdFrames[RollbackSession::NumPlayers] = { 0, 0 };
+
+};
+
+//______________________________________________________________________________
+//! Inputs read from a file, one frame per line
+static bool LoadScriptedInputs(const std::string& path, std::vector<InputState>& inputs)
+{
+  std::ifstream file(path);
+  if (!file)
+    return false;
+
+  unsigned int p1 = 0, p2 = 0;
+  while (file >> p1 >> p2)
+  {
+    inputs.push_back(static_cast<InputState>(p1));
+    inputs.push_back(static_cast<InputState>(p2));
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+static void PrintTiming(const char* name, const SyncTest::Timing& timing)
+{
+  std::cout << "  " << name << ": " << timing.count << " times, avg " << timing.AverageMicroseconds() << " us, max "
+    << timing.maxMicroseconds << " us, total " << timing.totalMicroseconds / 1000.0 << " ms\n";
+}
+
+int main(int argc, char* args[])
+{
+  SyncTest::Config config;
+  bool measure = false;
+  unsigned int seed = 0;
+  std::string inputFile, p1Character, p2Character;
+  for (int i = 1; i < argc; i++)
+  {
+    const std::string arg = args[i];
+    if (arg == "--frames" && i + 1 < argc)
+      config.frames = std::stoi(args[++i]);
+    else if (arg == "--rollback" && i + 1 < argc)
+      config.rollbackFrames = std::stoi(args[++i]);
+    else if (arg == "--seed" && i + 1 < argc)
+      seed = static_cast<unsigned int>(std::stoul(args[++i]));
+    else if (arg == "--inputs" && i + 1 < argc)
+      inputFile = args[++i];
+    else if (arg == "--p1" && i + 1 < argc)
+      p1Character = args[++i];
+    else if (arg == "--p2" && i + 1 < argc)
+      p2Character = args[++i];
+    else if (arg == "--serial")
+      SystemScheduler::Parallel = false;
+    else if (arg == "--measure")
+      measure = true;
+  }
+
+  // a rolled back frame has to be written against one of the two keyframes that are kept
+  if (config.rollbackFrames > GameManager::KeyframeInterval)
+  {
+    std::cout << "Rolling back at most " << GameManager::KeyframeInterval << " frames\n";
+    config.rollbackFrames = GameManager::KeyframeInterval;
+  }
+
+  SyncTest::InputSource source = RandomInputs(seed);
+  std::vector<InputState> scripted;
+  if (!inputFile.empty())
+  {
+    if (!LoadScriptedInputs(inputFile, scripted))
+    {
+      std::cout << "Could not read inputs from " << inputFile << "\n";
+      return 2;
+    }
+    source = [&scripted](int frame, InputState* inputs)
+    {
+      for (int player = 0; player < RollbackSession::NumPlayers; player++)
+      {
+        const size_t index = static_cast<size_t>(frame) * RollbackSession::NumPlayers + player;
+        inputs[player] = index < scripted.size() ? scripted[index] : InputState::NONE;
+      }
+    };
+  }
+
+  ResourceManager::Get().Initialize();
+  GameManager::Get().Initialize(true);
+
+  const std::vector<std::string> characters = GAnimArchive.GetCharacters();
+  if (characters.empty())
+  {
+    std::cout << "No characters to fight with.\n";
+    return 2;
+  }
+  if (p1Character.empty())
+    p1Character = characters.front();
+  if (p2Character.empty())
+    p2Character = characters.front();
+
+  // training goes straight into the battle, both players are driven by the test's inputs
+  GameManager::Get().StartMatch(p1Character, p2Character, BattleType::Training);
+  GameManager::Get().AssignInputHandler(0, InputType::NetworkCtrl);
+  GameManager::Get().AssignInputHandler(1, InputType::NetworkCtrl);
+
+  std::cout << "Sync test: " << p1Character << " vs " << p2Character << ", " << config.frames << " frames, rolling back "
+    << config.rollbackFrames << " frames every frame, " << (inputFile.empty() ? "random inputs (seed " + std::to_string(seed) + ")" : "inputs from " + inputFile) << "\n";
+
+  SyncTest test(RollbackManager::Get(), config);
+  if (measure)
+  {
+    const SyncTest::Result result = test.Measure(source);
+    std::cout << "Measured " << result.save.count << " states: largest " << result.maxSnapshotBytes << " bytes, avg "
+      << (result.save.count > 0 ? result.totalSnapshotBytes / result.save.count : 0) << " bytes\n";
+    PrintTiming("save", result.save);
+    PrintTiming("shown frame", result.presentFrame);
+
+    ResourceManager::Get().Destroy();
+    GameManager::Get().Destroy();
+    return 0;
+  }
+
+  const SyncTest::Result result = test.Run(source);
+
+  if (result.Passed())
+    std::cout << "PASSED: all " << result.framesRun << " frames match\n";
+  else
+  {
+    std::cout << "FAILED: frame " << result.firstDivergentFrame << " diverged ";
+    if (result.divergentRollbackFrom == SyncTest::Result::NoFrame)
+      std::cout << "without rolling back";
+    else
+      std::cout << "after rolling back to frame " << result.divergentRollbackFrom;
+    std::cout << " (checksum " << std::hex << result.actualChecksum << ", expected " << result.expectedChecksum << std::dec << ")\n";
+    GameManager::LogSnapshotMismatches(std::cout, result.mismatches);
+  }
+
+  std::cout << result.rollbacks << " rollbacks, largest state " << result.maxSnapshotBytes << " bytes\n";
+  PrintTiming("save", result.save);
+  PrintTiming("load", result.load);
+  PrintTiming("resimulate", result.resimulate);
+  PrintTiming("shown frame", result.presentFrame);
+  PrintTiming("resimulated frame", result.resimulatedFrame);
+
+  ResourceManager::Get().Destroy();
+  GameManager::Get().Destroy();
+
+  return result.Passed() ? 0 : 1;
+}
@@ -33,7 +33,7 @@ void TimedActionSystem::DoTick(float dt)
       actor.forceNewInputOnNextFrame = true;
       // remove system flag at the end of the system call
       
-      RunOnDeferGuardDestroy(entity, GameManager::Get().GetEntityByID(entity)->RemoveComponent<TimedActionComponent>());
+      EntityCommandBuffer::Get().RemoveComponent<TimedActionComponent>(entity);
       //guard.deferred.emplace(guard.deferred.begin(), [&](){ GameManager::Get().GetEntityByID(entity)->RemoveComponent<TimedActionComponent>(); });
     }
   }
@@ -137,20 +137,19 @@ void HandleInputGrappling::DoTick(float dt)
 
     if (state.triedToThrowThisFrame && !state.throwSuccess)
     {
-      RunOnDeferGuardDestroy((entity, state), {
-        GameManager::Get().GetEntityByID(entity)->AddComponent<EnactActionComponent>();
-        // set up animation
-        GameManager::Get().GetEntityByID(entity)->AddComponent<AnimatedActionComponent>({ state.onLeftSide, false, true, 1.0f, "ThrowMiss" });
-        GameManager::Get().GetEntityByID(entity)->AddComponent<WaitForAnimationComplete>();
-        
-        GameManager::Get().GetEntityByID(entity)->RemoveComponent<AttackActionComponent>();
-        GameManager::Get().GetEntityByID(entity)->RemoveComponent<AttackStateComponent>();
-        GameManager::Get().GetEntityByID(entity)->RemoveComponent<GrappleActionComponent>();
-
-          // set empty component for follow up action
-        GameManager::Get().GetEntityByID(entity)->AddComponent<TransitionToNeutral>();
-        GameManager::Get().GetEntityByID(entity)->RemoveComponent<InputListenerComponent>();
-      });
+      EntityCommandBuffer& commands = EntityCommandBuffer::Get();
+      commands.AddComponent<EnactActionComponent>(entity);
+      // set up animation
+      commands.AddComponent<AnimatedActionComponent>(entity, { state.onLeftSide, false, true, 1.0f, "ThrowMiss" });
+      commands.AddComponent<WaitForAnimationComplete>(entity);
+
+      commands.RemoveComponent<AttackActionComponent>(entity);
+      commands.RemoveComponent<AttackStateComponent>(entity);
+      commands.RemoveComponent<GrappleActionComponent>(entity);
+
+      // set empty component for follow up action
+      commands.AddComponent<TransitionToNeutral>(entity);
+      commands.RemoveComponent<InputListenerComponent>(entity);
     }
   }
 }
@@ -432,20 +431,19 @@ void CheckSpecialAttackInputSystem::DoTick(float dt)
           RunOnDeferGuardDestroy((entity, &state), ActionFactory::SetAttackAction(entity, &state, "SpecialMove2", ActionState::HEAVY));
         }
 
-        RunOnDeferGuardDestroy(entity, {
-          // add additional cancelables for special moves here
-          // these might not work because they aren't implemented in any systems
-          // so they don't generate signatures
-          // entity->AddComponents<CancelOnDash, CancelOnJump>();
+        // add additional cancelables for special moves here
+        // these might not work because they aren't implemented in any systems
+        // so they don't generate signatures
+        // entity->AddComponents<CancelOnDash, CancelOnJump>();
 
-          // no cancel on hit ground for stuff like tatsu
-          GameManager::Get().GetEntityByID(entity)->RemoveComponent<CancelOnHitGround>();
-          GameManager::Get().GetEntityByID(entity)->RemoveComponent<CancelOnNormal>();
-          GameManager::Get().GetEntityByID(entity)->RemoveComponent<CancelOnSpecial>();
-          GameManager::Get().GetEntityByID(entity)->RemoveComponent<CrouchingAction>();
+        // no cancel on hit ground for stuff like tatsu
+        EntityCommandBuffer& commands = EntityCommandBuffer::Get();
+        commands.RemoveComponent<CancelOnHitGround>(entity);
+        commands.RemoveComponent<CancelOnNormal>(entity);
+        commands.RemoveComponent<CancelOnSpecial>(entity);
+        commands.RemoveComponent<CrouchingAction>(entity);
 
-          GameManager::Get().GetEntityByID(entity)->RemoveComponent<InputListenerComponent>();
-        });
+        commands.RemoveComponent<InputListenerComponent>(entity);
 
       }
     }
@@ -557,7 +555,7 @@ void CheckGrappleCancelOnHit::DoTick(float dt)
         StateComponent& state = ComponentArray<StateComponent>::Get().GetComponent(e2);
 
         state.thrownThisFrame = false;
-        RunOnDeferGuardDestroy(e2, GameManager::Get().GetEntityByID(e2)->RemoveComponent<ReceivedGrappleAction>());
+        EntityCommandBuffer::Get().RemoveComponent<ReceivedGrappleAction>(e2);
       }
     }
   }
@@ -686,10 +684,8 @@ void SpecialMoveCancelActionSystem::DoTick(float dt)
     // can only be cancelled on hit for now (replace with HittingComponent maybe?)
     if(state.hitting && ActionFactory::ActorDidSpecialInputRyu(&actor, &state))
     {
-      RunOnDeferGuardDestroy(entity, {
-        GameManager::Get().GetEntityByID(entity)->AddComponent<AbleToSpecialAttackState>();
-        GameManager::Get().GetEntityByID(entity)->RemoveComponent<CancelOnSpecial>();
-        });
+      EntityCommandBuffer::Get().AddComponent<AbleToSpecialAttackState>(entity);
+      EntityCommandBuffer::Get().RemoveComponent<CancelOnSpecial>(entity);
     }
   }
 }
@@ -713,10 +709,8 @@ void TargetComboCancelActionSystem::DoTick(float dt)
       {
         if (comboableMap.links[state.actionState] == actor.input.normal)
         {
-          RunOnDeferGuardDestroy(entity, {
-            GameManager::Get().GetEntityByID(entity)->AddComponent<AbleToAttackState>();
-            GameManager::Get().GetEntityByID(entity)->RemoveComponent<CancelOnNormal>();
-          });
+          EntityCommandBuffer::Get().AddComponent<AbleToAttackState>(entity);
+          EntityCommandBuffer::Get().RemoveComponent<CancelOnNormal>(entity);
         }
       }
     }
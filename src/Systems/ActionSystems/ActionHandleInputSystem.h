@@ -138,36 +138,6 @@ struct TargetComboCancelActionSystem : public ISystem<CancelOnNormal, AttackLink
 
 struct StateTransitionAggregate
 {
-  static void Check(Entity* entity)
-  {
-    CheckForMoveLeft::Check(entity);
-    CheckForMoveRight::Check(entity);
-    CheckForJump::Check(entity);
-    CheckForBeginCrouching::Check(entity);
-    CheckDashSystem::Check(entity);
-    CheckHitThisFrameSystem::Check(entity);
-    CheckForFalling::Check(entity);
-
-    CheckSpecialAttackInputSystem::Check(entity);
-    CheckAttackInputSystem::Check(entity);
-
-    HitGroundCancelActionSystem::Check(entity);
-    SpecialMoveCancelActionSystem::Check(entity);
-    TargetComboCancelActionSystem::Check(entity);
-
-    ListenForAirborneSystem::Check(entity);
-    TransitionToNeutralSystem::Check(entity);
-
-    CheckKnockdownComplete::Check(entity);
-
-    CheckKnockdownOTG::Check(entity);
-
-    CheckCrouchingFollowUp::Check(entity);
-
-    CheckGrappleCancelOnHit::Check(entity);
-    CheckForReturnToNeutral::Check(entity);
-  }
-
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -203,19 +173,6 @@ struct StateTransitionAggregate
 
 struct HandleUpdateAggregate
 {
-  static void Check(Entity* entity)
-  {
-    // timed action system gets handled in scene update because it needs to go
-    // after enact... maybe not appropriate to have in this aggregate
-    TimedActionSystem::Check(entity);
-
-    HandleInputJump::Check(entity);
-    HandleInputCrouch::Check(entity);
-    HandleInputGrappledActionSystem::Check(entity);
-    HandleDashUpdateSystem::Check(entity);
-    HandleInputGrappling::Check(entity);
-  }
-
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
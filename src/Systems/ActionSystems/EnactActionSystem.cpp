@@ -3,6 +3,7 @@
 #include "Managers/AnimationCollectionManager.h"
 
 #include "Core/Utility/DeferGuard.h"
+#include "Core/ECS/SystemScheduler.h"
 
 void EnactAnimationActionSystem::DoTick(float dt)
 {
@@ -101,8 +102,9 @@ void EnactActionDamageSystem::DoTick(float dt)
       state.hp -= action.damageAmount;
     }
 
+    // the sparks entity isn't part of the saved state, so resimulated frames don't spawn them
     SFXComponent& sfx = ComponentArray<SFXComponent>::Get().GetComponent(entity);
-    if (GlobalVars::ShowHitEffects)
+    if (GlobalVars::ShowHitEffects && SystemScheduler::Presenting())
     {
       if (action.isBlocking)
         sfx.ShowBlockSparks(state.onLeftSide);
@@ -143,11 +145,8 @@ void CleanUpActionSystem::PostUpdate()
   DeferGuard guard;
   for (const EntityID& entity : Registered)
   {
-    EntityID id = entity;
-    RunOnDeferGuardDestroy(entity,
-      GameManager::Get().GetEntityByID(entity)->RemoveComponent<EnactActionComponent>();
+    EntityCommandBuffer::Get().RemoveComponent<EnactActionComponent>(entity);
     // we want to be listening for a new action now
-    GameManager::Get().GetEntityByID(entity)->AddComponent<InputListenerComponent>();
-    );
+    EntityCommandBuffer::Get().AddComponent<InputListenerComponent>(entity);
   }
 }
@@ -56,20 +56,6 @@ struct CleanUpActionSystem : public ISystem<EnactActionComponent>
 
 struct EnactAggregate
 {
-  static void Check(Entity* entity)
-  {
-    EnactAnimationActionSystem::Check(entity);
-    EnactAttackActionSystem::Check(entity);
-    EnactGrappleActionSystem::Check(entity);
-    EnactActionMovementSystem::Check(entity);
-    EnactActionDamageSystem::Check(entity);
-    EnactGrappledSystem::Check(entity);
-    CleanUpActionSystem::Check(entity);
-
-    // just needs to be here to generate component id for losercomponent
-    //LoserSystem::Check(entity);
-  }
-
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
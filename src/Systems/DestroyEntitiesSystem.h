@@ -4,7 +4,7 @@
 
 #include "Core/Utility/DeferGuard.h"
 
-struct DestroyOnSceneEnd : public IComponent {};
+struct DestroyOnSceneEnd : public ITag {};
 
 class DestroyEntitiesSystem : public ISystem<DestroyOnSceneEnd>
 {
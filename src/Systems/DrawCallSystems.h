@@ -11,14 +11,10 @@ public:
   static void PostUpdate()
   {
     PROFILE_FUNCTION();
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, Transform& transform, RenderComponent<RenderType>& renderer, RenderProperties& properties)
     {
-      RenderComponent<RenderType>& renderer = ComponentArray<RenderComponent<RenderType>>::Get().GetComponent(entity);
-      Transform& transform = ComponentArray<Transform>::Get().GetComponent(entity);
-      RenderProperties& properties = ComponentArray<RenderProperties>::Get().GetComponent(entity);
-
       // if the render resource hasn't been assigned yet, hold off
-      if (!renderer.GetRenderResource()) continue;
+      if (!renderer.GetRenderResource()) return;
 
       // get a display op to set draw parameters
       auto displayOp = GRenderer.GetAvailableOp<BlitOperation<RenderType>>(RenderLayer::World);
@@ -45,7 +41,7 @@ public:
       displayOp->displayColor = properties.GetDisplayColor();
 
       displayOp->valid = true;
-    }
+    });
   }
 };
 
@@ -56,12 +52,8 @@ public:
   static void PostUpdate()
   {
     PROFILE_FUNCTION();
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, UITransform& transform, TextRenderer& renderer, RenderProperties& properties)
     {
-      TextRenderer& renderer = ComponentArray<TextRenderer>::Get().GetComponent(entity);
-      RenderProperties& properties = ComponentArray<RenderProperties>::Get().GetComponent(entity);
-      UITransform& transform = ComponentArray<UITransform>::Get().GetComponent(entity);
-
       Vector2<float> displayPosition = transform.screenPosition;
 
       for (GLDrawOperation& drawOp : renderer.GetRenderOps())
@@ -87,7 +79,7 @@ public:
 
         displayOp->valid = true;
       }
-    }
+    });
   }
 };
 
@@ -96,12 +88,8 @@ class DrawUIPrimitivesSystem : public ISystem<UITransform, UIRectangleRenderComp
 public:
   static void PostUpdate()
   {
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, UITransform& transform, UIRectangleRenderComponent& uiElement, RenderProperties& properties)
     {
-      UIRectangleRenderComponent& uiElement = ComponentArray<UIRectangleRenderComponent>::Get().GetComponent(entity);
-      RenderProperties& properties = ComponentArray<RenderProperties>::Get().GetComponent(entity);
-      UITransform& transform = ComponentArray<UITransform>::Get().GetComponent(entity);
-
       auto processOps = [&uiElement, &transform, &properties](DrawPrimitive<RenderType>* displayOp)
       {
         displayOp->targetRect.x += transform.screenPosition.x;
@@ -122,6 +110,6 @@ public:
       op->filled = uiElement.isFilled;
 
       processOps(op);
-    }
+    });
   }
 };
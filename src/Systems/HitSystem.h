@@ -140,6 +140,10 @@ public:
 class FrameAdvantageSystem : public IMultiSystem<SysComponents<AttackStateComponent, Animator, RenderProperties>, SysComponents<HitStateComponent, TimedActionComponent>>
 {
 public:
+  // only reads the loaded animation data besides its components
+  using ReadsOnly = Requires<AttackStateComponent, Animator, HitStateComponent, TimedActionComponent>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
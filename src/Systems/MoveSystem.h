@@ -21,6 +21,9 @@ struct WallMoveComponent : public IComponent
 class MoveWallSystem : public IMultiSystem<SysComponents<Camera>, SysComponents<WallMoveComponent, StaticCollider, Transform>>
 {
 public:
+  using ReadsOnly = Requires<Camera, WallMoveComponent>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -50,6 +53,9 @@ public:
 class MoveSystemCamera : public ISystem<Transform, Camera>
 {
 public:
+  using ReadsOnly = Requires<Transform>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -90,6 +96,9 @@ public:
 class CameraFollowPlayerSystem : public IMultiSystem<SysComponents<Transform, Camera, CameraFollowsPlayers>, SysComponents<Transform, Actor>>
 {
 public:
+  using ReadsOnly = Requires<CameraFollowsPlayers, Actor>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -122,57 +131,58 @@ public:
 class MoveSystemPhysCollider : public ISystem<Transform, DynamicCollider>
 {
 public:
+  using ReadsOnly = Requires<Transform>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, Transform& transform, DynamicCollider& rect)
     {
-      Transform& transform = ComponentArray<Transform>::Get().GetComponent(entity);
-      DynamicCollider& rect = ComponentArray<DynamicCollider>::Get().GetComponent(entity);
-
       rect.MoveToTransform(transform);
-      
-    }
+    });
   }
 };
 
 class MoveSystemHurtbox : public ISystem<Transform, Hurtbox>
 {
 public:
+  using ReadsOnly = Requires<Transform>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, Transform& transform, Hurtbox& hurtbox)
     {
-      Transform& transform = ComponentArray<Transform>::Get().GetComponent(entity);
-      Hurtbox& hurtbox = ComponentArray<Hurtbox>::Get().GetComponent(entity);
-
       hurtbox.MoveToTransform(transform);
-      
-    }
+    });
   }
 };
 
 class MoveSystemHitbox : public ISystem<Transform, Hitbox>
 {
 public:
+  using ReadsOnly = Requires<Transform>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
-    for (const EntityID& entity : Registered)
+    ForEach([](EntityID entity, Transform& transform, Hitbox& hitbox)
     {
-      Transform& transform = ComponentArray<Transform>::Get().GetComponent(entity);
-      Hitbox& hitbox = ComponentArray<Hitbox>::Get().GetComponent(entity);
-
       if (hitbox.travelWithTransform)
         hitbox.MoveToTransform(transform);
-    }
+    });
   }
 };
 
 class MoveThrownEntitySystem : public IMultiSystem<SysComponents<ThrowFollower, TeamComponent>, SysComponents<Transform, Hurtbox, ReceivedGrappleAction>>
 {
 public:
+  using ReadsOnly = Requires<ThrowFollower, TeamComponent, Hurtbox, ReceivedGrappleAction>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -197,16 +207,6 @@ public:
 class MoveSystem : public ISystem<>
 {
 public:
-  static void Check(Entity* e)
-  {
-    MoveSystemPhysCollider::Check(e);
-    MoveSystemHurtbox::Check(e);
-    MoveSystemHitbox::Check(e);
-    MoveThrownEntitySystem::Check(e);
-    CameraFollowPlayerSystem::Check(e);
-    MoveSystemCamera::Check(e);
-  }
-
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -10,6 +10,9 @@
 
 struct ApplyGravitySystem : public ISystem<Rigidbody, Gravity>
 {
+  using ReadsOnly = Requires<Gravity>;
+  static constexpr bool Exclusive = false;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -26,6 +29,11 @@ struct ApplyGravitySystem : public ISystem<Rigidbody, Gravity>
 class PhysicsSystem : public ISystem<DynamicCollider, Rigidbody, Transform>
 {
 public:
+  // moves against every other dynamic and static collider
+  using ReadsOnly = Requires<DynamicCollider>;
+  using AlsoReads = Requires<StaticCollider>;
+  static constexpr bool Exclusive = false;
+
   friend struct Rigidbody;
   static void DoTick(float dt);
 
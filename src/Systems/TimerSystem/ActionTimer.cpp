@@ -1,27 +1,21 @@
 #include "Systems/TimerSystem/ActionTimer.h"
 
-void ActionTimer::Serialize(std::ostream& os) const
+//______________________________________________________________________________
+void TimerCallbacks::Register(Kind kind, CompleteFunc onComplete, UpdateFunc onUpdate)
 {
-  os << playTime;
-  os << currFrame;
-  os << _totalFrames;
+  _callbacks[kind] = Entry{ std::move(onUpdate), std::move(onComplete) };
 }
 
-void ActionTimer::Deserialize(std::istream& is)
+//______________________________________________________________________________
+void TimerCallbacks::Update(ID id, EntityID owner, int elapsed, int duration) const
 {
-  is >> playTime;
-  is >> currFrame;
-  is >> _totalFrames;
+  if (id < Count && _callbacks[id].onUpdate)
+    _callbacks[id].onUpdate(owner, elapsed, duration);
 }
 
-void SimpleActionTimer::OnComplete()
+//______________________________________________________________________________
+void TimerCallbacks::Complete(ID id, EntityID owner) const
 {
-  if (!_cancelled)
-    _callback();
-}
-
-void ComplexActionTimer::Update()
-{
-  if(!_cancelled)
-    _updater(currFrame, _totalFrames);
+  if (id < Count && _callbacks[id].onComplete)
+    _callbacks[id].onComplete(owner);
 }
@@ -1,85 +1,71 @@
 #pragma once
-#include "Core/Interfaces/Serializable.h"
-#include <functional>
-
-//______________________________________________________________________________
-class ActionTimer : public ISerializable
-{
-public:
-  ActionTimer(int duration) :
-    playTime(0),
-    currFrame(0),
-    _totalFrames(duration) {}
-
-  virtual ~ActionTimer() = default;
-  //! num frames the total action goes for
-  int const Duration() { return _totalFrames; }
-
-  //! Serializing functions (might not ever use)
-  virtual void Serialize(std::ostream& os) const override;
-  virtual void Deserialize(std::istream& is) override;
-  std::string Log() override { return ""; }
-
-  //! gets whether or not this action has been cancelled preemptively
-  virtual bool const Cancelled() = 0;
-  //! callback for when the timer completes
-  virtual void OnComplete() = 0;
-  //! cancels the action timer
-  virtual void Cancel() = 0;
-  //! callback for on each frame update
-  virtual void Update() = 0;
-
-  //! how long has this been playing in real seconds
-  float playTime;
-  //! what frame of timer is this one
-  int currFrame;
-
-protected:
-  //! total length of action timer in frames
-  int _totalFrames;
+#include "Globals.h"
 
-};
+#include <cstdint>
+#include <functional>
 
 //______________________________________________________________________________
-//! Drives the animation - only calls the action's on complete function no update
-class SimpleActionTimer : public ActionTimer
+//! Registry of what timers do when they update and complete. Timers only hold the ID of their callbacks, so they copy
+//! in and out of a snapshot like any other data and a resimulated timer calls the same code. IDs are a fixed list of
+//! kinds rather than handed out as callbacks are registered, so a timer restored from a replay or another process
+//! points at the same callback. Callbacks are registered once at startup and can't capture anything, whatever they
+//! act on is looked up from the entity the timer runs on. A kind with nothing registered does nothing
+class TimerCallbacks
 {
 public:
-  typedef std::function<void()> CompleteFunc;
-
-  SimpleActionTimer(CompleteFunc onComplete, int duration) :
-    _callback(onComplete),
-    _cancelled(false),
-    ActionTimer(duration) {}
-
-  //! Return cancelled status
-  virtual bool const Cancelled() override { return _cancelled; }
-  //! If it hasn't been cancelled yet, run the callback
-  virtual void OnComplete() override;
-  //! Set this to cancelled so it doesn't run callback
-  virtual void Cancel() override { _cancelled = true; }
-  //! nothing happens on update
-  virtual void Update() override {}
-
-protected:
-  CompleteFunc _callback;
-  bool _cancelled;
+  using ID = uint32_t;
+
+  enum Kind : ID
+  {
+    None = 0,
+    //! Removes the render properties of the owner to hide it
+    HideOwner,
+    //! Nothing is registered, DefendAfter checks whether the timer is still running
+    ResetDefense,
+    //! Fades the target of the owner's AlphaFader
+    FadeAlpha,
+    //! Completes the owner's WaitForTime
+    FinishWait,
+    Count
+  };
+
+  //! Called every frame the timer runs, before it moves on, with the frames it has run for and its duration
+  typedef std::function<void(EntityID owner, int elapsed, int duration)> UpdateFunc;
+  //! Called when the timer runs out
+  typedef std::function<void(EntityID owner)> CompleteFunc;
+
+  //! Static getter
+  static TimerCallbacks& Get()
+  {
+    static TimerCallbacks callbacks;
+    return callbacks;
+  }
+
+  //! Sets what timers of the kind do, replacing what was registered before
+  void Register(Kind kind, CompleteFunc onComplete, UpdateFunc onUpdate = nullptr);
+
+  void Update(ID id, EntityID owner, int elapsed, int duration) const;
+  void Complete(ID id, EntityID owner) const;
+
+private:
+  struct Entry
+  {
+    UpdateFunc onUpdate;
+    CompleteFunc onComplete;
+  };
+
+  Entry _callbacks[Count];
 
 };
 
 //______________________________________________________________________________
-class ComplexActionTimer : public SimpleActionTimer
+//! A running timer. Plain data (no padding) so it is saved with the rest of the rollback state
+struct ActionTimer
 {
-public:
-  typedef std::function<void(float, float)> TFunction;
-  ComplexActionTimer(TFunction updater, CompleteFunc onComplete, int duration) :
-    _updater(updater),
-    SimpleActionTimer(onComplete, duration) {}
-
-  //! updates based on the length of animation play
-  virtual void Update() override;
-
-protected:
-  TFunction _updater;
-
+  //! What the timer does, looked up in TimerCallbacks
+  TimerCallbacks::ID callback;
+  //! Total length of the timer in frames
+  int32_t duration;
+  //! Frames the timer has run for
+  int32_t elapsed;
 };
@@ -0,0 +1,68 @@
+#include "Systems/TimerSystem/TimerContainer.h"
+
+#include <cassert>
+
+//______________________________________________________________________________
+bool TimerContainer::Start(TimerCallbacks::ID callback, int duration)
+{
+  assert(count < MaxTimers && "Too many timers running on one entity");
+  if (count >= MaxTimers)
+    return false;
+
+  timers[count++] = ActionTimer{ callback, duration, 0 };
+  return true;
+}
+
+//______________________________________________________________________________
+void TimerContainer::Cancel(TimerCallbacks::ID callback)
+{
+  int kept = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (timers[i].callback != callback)
+      timers[kept++] = timers[i];
+  }
+  for (int i = kept; i < count; i++)
+    timers[i] = ActionTimer{};
+  count = kept;
+}
+
+//______________________________________________________________________________
+void TimerContainer::CancelAll()
+{
+  for (int i = 0; i < count; i++)
+    timers[i] = ActionTimer{};
+  count = 0;
+}
+
+//______________________________________________________________________________
+bool TimerContainer::Running(TimerCallbacks::ID callback) const
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (timers[i].callback == callback)
+      return true;
+  }
+  return false;
+}
+
+//______________________________________________________________________________
+void TimerContainer::Advance(EntityID owner, std::vector<TimerCallbacks::ID>& finished)
+{
+  int kept = 0;
+  for (int i = 0; i < count; i++)
+  {
+    ActionTimer timer = timers[i];
+
+    // always update first
+    TimerCallbacks::Get().Update(timer.callback, owner, timer.elapsed, timer.duration);
+
+    if (++timer.elapsed >= timer.duration)
+      finished.push_back(timer.callback);
+    else
+      timers[kept++] = timer;
+  }
+  for (int i = kept; i < count; i++)
+    timers[i] = ActionTimer{};
+  count = kept;
+}
@@ -2,12 +2,32 @@
 #include "Core/ECS/IComponent.h"
 #include "Systems/TimerSystem/ActionTimer.h"
 
+#include <vector>
+
+//______________________________________________________________________________
+//! Timers running on an entity. They are stored in place, so the component snapshots as raw bytes and a loaded
+//! snapshot brings back exactly the timers that were running. Removing the component drops its timers without
+//! completing them, since loading a snapshot removes components too
 struct TimerContainer : public IComponent
 {
-  void OnRemove(const EntityID& entity) override
-  {
-    for (auto timing : timings)
-      timing->OnComplete();
-  }
-  std::vector<std::shared_ptr<ActionTimer>> timings;
+  //! Most timers that can run on one entity at once
+  static constexpr int MaxTimers = 8;
+
+  //! Starts a timer that completes after duration frames. Returns false if the container is full
+  bool Start(TimerCallbacks::ID callback, int duration);
+  //! Stops the running timers with the callback without completing them
+  void Cancel(TimerCallbacks::ID callback);
+  //! Stops every running timer without completing it
+  void CancelAll();
+  //! Whether a timer with the callback is running
+  bool Running(TimerCallbacks::ID callback) const;
+  //! Updates every timer and moves it a frame on. Timers that run out are removed and their callbacks added to
+  //! finished in the order the timers were started, to be completed once nothing holds on to the container
+  void Advance(EntityID owner, std::vector<TimerCallbacks::ID>& finished);
+
+  //! Running timers in the order they were started. Slots from count on are zeroed so they snapshot the same
+  ActionTimer timers[MaxTimers] = {};
+  int count = 0;
 };
+
+template <> struct TrivialSnapshot<TimerContainer> : TrivialSnapshotRange<TimerContainer, &TimerContainer::timers, &TimerContainer::count> {};
@@ -5,47 +5,24 @@
 class TimerSystem : public ISystem<TimerContainer>
 {
 public:
+  //! Timers count frames, so every tick is one frame whatever the time step. A tick with no time step (hitstop) freezes
+  //! them like every other system
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
+    if (dt <= 0)
+      return;
+
+    // kept between ticks for its memory
+    static std::vector<TimerCallbacks::ID> finished;
     for(const EntityID& entity : Registered)
     {
-      std::vector<std::shared_ptr<ActionTimer>>& _timings = ComponentArray<TimerContainer>::Get().GetComponent(entity).timings;
-      std::vector<int> markedForDelete;
-      for (int i = 0; i < _timings.size(); i++)
-      {
-        std::shared_ptr<ActionTimer> timer = _timings[i];
-
-        // always update first
-        timer->Update();
-
-        if (timer->playTime >= secPerFrame)
-        {
-          int framesToAdv = (int)std::floor(timer->playTime / secPerFrame);
-
-          if ((timer->currFrame + framesToAdv) >= timer->Duration())
-          {
-            if(!timer->Cancelled())
-              timer->OnComplete();
-            markedForDelete.push_back(i);
-          }
-          else
-          {
-            timer->currFrame += framesToAdv;
-          }
-
-          timer->playTime -= (framesToAdv * secPerFrame);
-        }
-        // if playing, do advance time and update frame
-        timer->playTime += dt;
-      }
+      finished.clear();
+      ComponentArray<TimerContainer>::Get().GetComponent(entity).Advance(entity, finished);
 
-      int offset = 0;
-      for (int& index : markedForDelete)
-      {
-        _timings.erase(_timings.begin() + (index + offset));
-        offset--;
-      }
+      // completing can start timers or add components, so it waits until the container has been let go of
+      for (const TimerCallbacks::ID callback : finished)
+        TimerCallbacks::Get().Complete(callback, entity);
     }
   }
 };
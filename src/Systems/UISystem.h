@@ -9,6 +9,9 @@ const Rect<float> ScreenRect(0, 0, m_nativeWidth, m_nativeHeight);
 class UIPositionUpdateSystem : public ISystem<UITransform>
 {
 public:
+  static constexpr bool Exclusive = false;
+  static constexpr bool Presentation = true;
+
   static void CalcScreenPos(UITransform* transform, Rect<float> parentRect, float x, float y)
   {
     switch(transform->anchor)
@@ -51,6 +54,9 @@ public:
 class UIContainerUpdateSystem : public ISystem<UIContainer, StateComponent>
 {
 public:
+  //! The UI catches up with the state of the shown frame, lastState is whatever the UI showed last
+  static constexpr bool Presentation = true;
+
   static void DoTick(float dt)
   {
     PROFILE_FUNCTION();
@@ -18,7 +18,7 @@ void WallPushSystem::DoTick(float dt)
     if (std::fabs(push.amountPushed) >= std::fabs(push.pushAmount))
     {
       rigidbody.velocity.x = 0;
-      RunOnDeferGuardDestroy(entity, GameManager::Get().GetEntityByID(entity)->RemoveComponent<WallPushComponent>());
+      EntityCommandBuffer::Get().RemoveComponent<WallPushComponent>(entity);
     }
   }
 }